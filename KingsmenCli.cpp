@@ -0,0 +1,580 @@
+/* ************************KINGSMEN CHESS CLI******************************* */
+/* Runs the Kingsmen Chess engine from the command line, without a window:      */
+/*                                                                               */
+/*   kingsmen perft  <depth> [fen] [--mailbox|--bitboard]                        */
+/*   kingsmen divide <depth> [fen] [--mailbox|--bitboard]                        */
+/*   kingsmen search <depth> [fen] [--time <seconds>] [--threads <n>]            */
+/*   kingsmen epd <file> perft|eval|search [depth] [--threads <n>]              */
+/*                [--mailbox|--bitboard]                                         */
+/*   kingsmen --uci      (talks the Universal Chess Interface on stdin/stdout)   */
+/* ***************************************************************************** */
+
+#include "KingsmenEngine.h"
+#include <iostream>
+#include <sstream>
+#ifndef OS_WINDOWS
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// namespaces
+using namespace std;
+
+
+// Function Table of Contents
+int  runSearchCommand			(int argc, char* argv[]);
+int  runPerftCommand			(int argc, char* argv[]);
+int  runEpdCommand				(int argc, char* argv[]);
+int  runEpdLine					(const char *line, const char *lineEnd, int lineNumber, int mode, int depth);
+int  findPerftCount				(const char *line, const char *lineEnd, int depth, unsigned long long &count);
+const char *mapFile				(const char *fileName, size_t &size);
+void unmapFile					(const char *data, size_t size);
+int  runUciCommand				(void);
+void uciPosition				(istringstream &tokens);
+void uciGo						(istringstream &tokens);
+void uciSetOption				(istringstream &tokens);
+void uciSearch					(searchLimitsStruct limits, int infinite);
+void uciStopSearch				(void);
+
+// global variables
+boardClass board; // the position being worked on, set up from a fen by each command
+thread uciSearchThread; // the search started by the last "go", until it has been joined
+atomic<int> uciStopRequested(0); // set by "stop"; an infinite search may only give its move after that
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && (strcmp(argv[1], "perft")==0 || strcmp(argv[1], "divide")==0))
+		return runPerftCommand(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "search")==0)
+		return runSearchCommand(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "epd")==0)
+		return runEpdCommand(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "--uci")==0)
+		return runUciCommand();
+
+	printf("usage: %s perft <depth> [fen] [--mailbox|--bitboard]\n", argv[0]);
+	printf("       %s divide <depth> [fen] [--mailbox|--bitboard]\n", argv[0]);
+	printf("       %s search <depth> [fen] [--time <seconds>] [--threads <n>]\n", argv[0]);
+	printf("       %s epd <file> perft|eval|search [depth] [--threads <n>] [--mailbox|--bitboard]\n", argv[0]);
+	printf("       %s --uci\n", argv[0]);
+	return 1;
+}
+
+int runPerftCommand(int argc, char* argv[])
+{
+	// Handles the headless "perft <depth> [fen]" and "divide <depth> [fen]" command line modes.
+	//	The fen may be given as one quoted argument or as the remaining arguments. Adding "--mailbox"
+	//	or "--bitboard" anywhere after the mode selects the move generator.
+
+	int i, j;
+	for (i=j=2; i<argc; i++)
+	{
+		if (strcmp(argv[i], "--bitboard")==0)
+			moveGenBackend = 1;
+		else if (strcmp(argv[i], "--mailbox")==0)
+			moveGenBackend = 0;
+		else
+			argv[j++] = argv[i];
+	}
+	argc = j;
+
+	if (argc < 3 || atoi(argv[2]) < 1)
+	{
+		printf("usage: %s perft <depth> [fen] [--mailbox|--bitboard]\n", argv[0]);
+		printf("       %s divide <depth> [fen] [--mailbox|--bitboard]\n", argv[0]);
+		return 1;
+	}
+	int depth = atoi(argv[2]);
+
+	string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	if (argc > 3)
+	{
+		fen = argv[3];
+		for (i=4; i<argc; i++)
+			fen = fen + " " + argv[i];
+	}
+
+	if (!loadFen(fen.c_str(), board))
+	{
+		printf("Unable to load fen: %s\n", fen.c_str());
+		return 1;
+	}
+
+	printf("\nPERFT\n");
+	printf("\tFen: %s\n", fen.c_str());
+	printf("\tMove generator: %s\n\n", moveGenBackend == 1 ? "bitboard" : "mailbox");
+	displayBoardText(board.board);
+	printf("\n");
+
+	if (strcmp(argv[1], "divide")==0)
+	{
+		perftDivide(board, depth);
+		return 0;
+	}
+
+	for (int d=1; d<=depth; d++)
+	{
+		double startTime = getTimeInSeconds();
+		unsigned long long nodes = perft(board, d);
+		double elapsed = getTimeInSeconds() - startTime;
+
+		printf("\tDepth %2d: %12llu nodes  %8.3f s  %12.0f nodes/s\n", d, nodes, elapsed, elapsed > 0 ? nodes/elapsed : 0.0);
+	}
+
+	return 0;
+}
+
+int runSearchCommand(int argc, char* argv[])
+{
+	// Handles the headless "search <depth> [fen] [--time <seconds>] [--threads <n>]" command line mode, which
+	//	searches a position and prints the best move.
+
+	int i, j;
+	double seconds = 0;
+	for (i=j=2; i<argc; i++)
+	{
+		if (strcmp(argv[i], "--time")==0 && i+1 < argc)
+			seconds = atof(argv[++i]);
+		else if (strcmp(argv[i], "--threads")==0 && i+1 < argc)
+			searchThreads = atoi(argv[++i]);
+		else
+			argv[j++] = argv[i];
+	}
+	argc = j;
+
+	if (argc < 3 || atoi(argv[2]) < 1)
+	{
+		printf("usage: %s search <depth> [fen] [--time <seconds>] [--threads <n>]\n", argv[0]);
+		return 1;
+	}
+	int depth = atoi(argv[2]);
+
+	string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	if (argc > 3)
+	{
+		fen = argv[3];
+		for (i=4; i<argc; i++)
+			fen = fen + " " + argv[i];
+	}
+
+	if (!loadFen(fen.c_str(), board))
+	{
+		printf("Unable to load fen: %s\n", fen.c_str());
+		return 1;
+	}
+
+	printf("\nSEARCH\n");
+	printf("\tFen: %s\n", fen.c_str());
+	printf("\tThreads: %d\n\n", searchThreads.load());
+	displayBoardText(board.board);
+
+	transpositionTable.resize(hashSizeMB);
+	searchLimitsStruct limits = {depth, seconds, searchOutputText};
+	searchResultStruct result;
+	stopSearch = 0;
+	searchPosition(board, limits, result);
+
+	char moveString[6] = "none";
+	if (result.bestMove.data)
+		moveToString(result.bestMove, moveString);
+	printf("\tBest move: %s  (score %d, depth %d, %llu nodes in %.3f s)\n", moveString, result.score, result.depth, result.nodes, result.seconds);
+
+	return 0;
+}
+
+const int epdPerft  = 0;
+const int epdEval   = 1;
+const int epdSearch = 2;
+
+int runEpdCommand(int argc, char* argv[])
+{
+	// Handles the headless "epd <file> perft|eval|search [depth] [--threads <n>] [--mailbox|--bitboard]" command
+	//	line mode, which runs every position in an EPD (or fen per line) file and prints one result line per
+	//	position:
+	//		perft   counts the moves to the given depth, and checks the count against the line's ";D<depth>"
+	//				operation if it has one (as perft suites do)
+	//		eval    gives the static evaluation, in centipawns from white's point of view
+	//		search  searches to the given depth and gives the best move
+	//	The file is memory mapped and every position is loaded straight from it, so even a file of
+	//	millions of positions is never copied or split up into strings.
+
+	int i, j;
+	for (i=j=2; i<argc; i++)
+	{
+		if (strcmp(argv[i], "--threads")==0 && i+1 < argc)
+			searchThreads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--bitboard")==0)
+			moveGenBackend = 1;
+		else if (strcmp(argv[i], "--mailbox")==0)
+			moveGenBackend = 0;
+		else
+			argv[j++] = argv[i];
+	}
+	argc = j;
+
+	int mode = -1;
+	if (argc > 3)
+		mode = strcmp(argv[3], "perft")==0 ? epdPerft : strcmp(argv[3], "eval")==0 ? epdEval : strcmp(argv[3], "search")==0 ? epdSearch : -1;
+	int depth = argc > 4 ? atoi(argv[4]) : 1;
+	if (mode < 0 || depth < 1 || depth >= maxSearchPly)
+	{
+		printf("usage: %s epd <file> perft|eval|search [depth] [--threads <n>] [--mailbox|--bitboard]\n", argv[0]);
+		return 1;
+	}
+
+	size_t size;
+	const char *data = mapFile(argv[2], size);
+	if (!data)
+	{
+		printf("Unable to read %s\n", argv[2]);
+		return 1;
+	}
+
+	setvbuf(stdout, NULL, _IOFBF, 1 << 16); // one write per 64 KB of results, not one per line
+	if (mode == epdSearch)
+		transpositionTable.resize(hashSizeMB);
+
+	int positions = 0, failed = 0, lineNumber = 0;
+	double startTime = getTimeInSeconds();
+	const char *line = data, *end = data + size;
+	// loadFen() stops at the end of the line, but the last line may have no newline after it, and the mapped file
+	//	has nothing after it to stop at; that one line gets copied
+	char lastLine[256];
+	while (line < end)
+	{
+		const char *lineEnd = (const char *)memchr(line, '\n', end - line);
+		if (!lineEnd)
+			lineEnd = end;
+		lineNumber++;
+
+		// Skip blank lines and comments
+		const char *c = line;
+		while (c < lineEnd && (*c == ' ' || *c == '\t' || *c == '\r')) c++;
+		if (c < lineEnd && *c != '#')
+		{
+			int copied = lineEnd == end;
+			if (copied)
+			{
+				size_t length = min((size_t)(lineEnd - line), sizeof(lastLine) - 1);
+				memcpy(lastLine, line, length);
+				lastLine[length] = '\0';
+				line    = lastLine;
+				lineEnd = lastLine + length;
+			}
+
+			positions++;
+			if (!runEpdLine(line, lineEnd, lineNumber, mode, depth))
+				failed++;
+			if (copied)
+				break;
+		}
+		line = lineEnd + 1;
+	}
+	double elapsed = getTimeInSeconds() - startTime;
+	unmapFile(data, size);
+
+	printf("# %d positions in %.3f s (%.0f positions/s), %d failed\n", positions, elapsed, elapsed > 0 ? positions/elapsed : 0.0, failed);
+	return failed ? 1 : 0;
+}
+
+int runEpdLine(const char *line, const char *lineEnd, int lineNumber, int mode, int depth)
+{
+	// Runs one position of runEpdCommand(); returns 0 if it couldn't be loaded or its perft count is wrong
+	if (!loadFen(line, board))
+	{
+		printf("%d error unable to load position\n", lineNumber);
+		return 0;
+	}
+
+	if (mode == epdPerft)
+	{
+		unsigned long long nodes = perft(board, depth), expected;
+		if (findPerftCount(line, lineEnd, depth, expected) && nodes != expected)
+		{
+			printf("%d perft %d %llu FAILED expected %llu\n", lineNumber, depth, nodes, expected);
+			return 0;
+		}
+		printf("%d perft %d %llu\n", lineNumber, depth, nodes);
+	}
+	else if (mode == epdEval)
+		printf("%d eval %d\n", lineNumber, lazyEval(board));
+	else
+	{
+		searchLimitsStruct limits = {depth, 0, searchOutputNone};
+		searchResultStruct result;
+		stopSearch = 0;
+		searchPosition(board, limits, result);
+
+		char moveString[6] = "none";
+		if (result.bestMove.data)
+			moveToString(result.bestMove, moveString);
+		printf("%d bestmove %s score %d depth %d nodes %llu\n", lineNumber, moveString, result.score, result.depth, result.nodes);
+	}
+	return 1;
+}
+
+int findPerftCount(const char *line, const char *lineEnd, int depth, unsigned long long &count)
+{
+	// Looks for the ";D<depth> <count>" operation perft suites give the expected move counts in
+	for (const char *c = line; c < lineEnd; c++)
+	{
+		if (*c != ';')
+			continue;
+		c++;
+		while (c < lineEnd && *c == ' ') c++;
+		if (c >= lineEnd || *c != 'D')
+			continue;
+
+		int operationDepth = 0;
+		for (c++; c < lineEnd && *c >= '0' && *c <= '9'; c++)
+			operationDepth = 10*operationDepth + (*c - '0');
+		if (operationDepth != depth)
+			continue;
+
+		while (c < lineEnd && *c == ' ') c++;
+		if (c >= lineEnd || *c < '0' || *c > '9')
+			return 0;
+		for (count = 0; c < lineEnd && *c >= '0' && *c <= '9'; c++)
+			count = 10*count + (*c - '0');
+		return 1;
+	}
+	return 0;
+}
+
+const char *mapFile(const char *fileName, size_t &size)
+{
+	// Maps a whole file into memory, read only; returns 0 if it can't be read
+#ifdef OS_WINDOWS
+	// No mmap here; read the file in instead
+	FILE *file = fopen(fileName, "rb");
+	if (!file)
+		return 0;
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	char *data = (char *)malloc(size ? size : 1);
+	size = fread(data, 1, size, file);
+	fclose(file);
+	return data;
+#else
+	int file = open(fileName, O_RDONLY);
+	if (file < 0)
+		return 0;
+	struct stat fileInfo;
+	if (fstat(file, &fileInfo) < 0)
+	{
+		close(file);
+		return 0;
+	}
+	size = fileInfo.st_size;
+	if (size == 0)
+	{
+		close(file);
+		return "";
+	}
+	void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+		return 0;
+	madvise(data, size, MADV_SEQUENTIAL);
+	return (const char *)data;
+#endif
+}
+
+void unmapFile(const char *data, size_t size)
+{
+#ifdef OS_WINDOWS
+	free((void *)data);
+#else
+	if (size)
+		munmap((void *)data, size);
+#endif
+}
+
+int runUciCommand()
+{
+	// Talks the Universal Chess Interface, so chess GUIs and tournament managers can run the engine: reads
+	//	commands from stdin a line at a time and answers on stdout. Searches run on their own thread, so
+	//	"stop", "isready" and the like are answered while the engine thinks.
+
+	setvbuf(stdout, NULL, _IOLBF, 0); // the GUI reads our answers through a pipe; don't sit on them
+	transpositionTable.resize(hashSizeMB);
+	loadFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", board);
+
+	string line;
+	while (getline(cin, line))
+	{
+		istringstream tokens(line);
+		string command;
+		tokens >> command;
+
+		if (command == "uci")
+		{
+			printf("id name Adrastos\n");
+			printf("id author Jeremy Wurbs\n");
+			printf("option name Hash type spin default %d min 1 max 65536\n", hashSizeMB);
+			printf("option name Threads type spin default %d min 1 max 256\n", searchThreads.load());
+			printf("uciok\n");
+		}
+		else if (command == "isready")
+			printf("readyok\n");
+		else if (command == "setoption")
+			uciSetOption(tokens);
+		else if (command == "ucinewgame")
+		{
+			uciStopSearch();
+			transpositionTable.clear();
+		}
+		else if (command == "position")
+			uciPosition(tokens);
+		else if (command == "go")
+			uciGo(tokens);
+		else if (command == "stop")
+			uciStopSearch();
+		else if (command == "quit")
+			break;
+	}
+
+	uciStopSearch();
+	return 0;
+}
+
+void uciPosition(istringstream &tokens)
+{
+	// "position startpos [moves <move> ...]" or "position fen <fen> [moves <move> ...]"
+	//	The position is set up on a board of its own and only replaces ours once all of it has been
+	//	understood, so a bad command leaves the previous position as it was
+	static boardClass position; // static because boards are too big for the stack
+	uciStopSearch();
+
+	string token, fen;
+	tokens >> token;
+	if (token == "startpos")
+	{
+		fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+		tokens >> token;
+	}
+	else if (token == "fen")
+	{
+		while (tokens >> token && token != "moves")
+			fen += fen.empty() ? token : " " + token;
+	}
+	else
+		return;
+
+	if (!loadFen(fen.c_str(), position))
+	{
+		printf("info string unable to load fen %s\n", fen.c_str());
+		return;
+	}
+
+	// token is now "moves", if there are any
+	while (tokens >> token)
+	{
+		moveStruct move;
+		if (!parseMove(position, token.c_str(), move))
+		{
+			printf("info string illegal move %s\n", token.c_str());
+			return;
+		}
+		makeMove(move, position);
+	}
+	board = position;
+}
+
+void uciGo(istringstream &tokens)
+{
+	// "go [depth <plies>] [movetime <ms>] [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>] [movestogo <n>] [infinite]"
+	uciStopSearch();
+
+	searchLimitsStruct limits = {maxSearchPly, 0, searchOutputUci};
+	int time[2] = {-1, -1}, increment[2] = {0, 0}; // [0]=white, [1]=black, in milliseconds
+	int movesToGo = 0, infinite = 0;
+
+	string token;
+	while (tokens >> token)
+	{
+		if      (token == "depth")     tokens >> limits.depth;
+		else if (token == "movetime")  { int ms; tokens >> ms; limits.seconds = ms/1000.0; }
+		else if (token == "wtime")     tokens >> time[0];
+		else if (token == "btime")     tokens >> time[1];
+		else if (token == "winc")      tokens >> increment[0];
+		else if (token == "binc")      tokens >> increment[1];
+		else if (token == "movestogo") tokens >> movesToGo;
+		else if (token == "infinite")  infinite = 1;
+	}
+
+	// With a clock, spend an even share of the time left (assuming 30 more moves if we aren't told) plus
+	//	most of the increment, keeping a little back for the time it takes the GUI to hear our move
+	int side = board.playersTurn ? 0 : 1;
+	if (!infinite && limits.seconds == 0 && time[side] >= 0)
+	{
+		double ms = time[side]/(movesToGo > 0 ? movesToGo : 30) + increment[side]*3/4;
+		ms = min(ms, time[side] - 50.0);
+		limits.seconds = max(ms, 10.0)/1000;
+	}
+	limits.depth = max(1, min(limits.depth, maxSearchPly));
+
+	stopSearch = 0;
+	uciStopRequested = 0;
+	uciSearchThread = thread(uciSearch, limits, infinite);
+}
+
+void uciSetOption(istringstream &tokens)
+{
+	// "setoption name <name> value <value>"; option names aren't case sensitive
+	string token, name, value;
+	tokens >> token; // "name"
+	while (tokens >> token && token != "value")
+		name += name.empty() ? token : " " + token;
+	tokens >> value;
+	for (size_t i=0; i<name.size(); i++)
+		name[i] = tolower(name[i]);
+
+	if (name == "hash" && atoi(value.c_str()) > 0)
+	{
+		uciStopSearch();
+		hashSizeMB = atoi(value.c_str());
+		transpositionTable.resize(hashSizeMB);
+	}
+	else if (name == "threads" && atoi(value.c_str()) > 0)
+		searchThreads = atoi(value.c_str());
+	else
+		printf("info string unknown option %s\n", name.c_str());
+}
+
+void uciSearch(searchLimitsStruct limits, int infinite)
+{
+	// The search thread: searches the board and gives the GUI the move it found
+	searchResultStruct result;
+	searchPosition(board, limits, result);
+
+	// "go infinite" must not give its move until the GUI says stop, even if the search ends by itself
+	//	(by finding a mate, say)
+	while (infinite && !uciStopRequested)
+		this_thread::sleep_for(chrono::milliseconds(1));
+
+	char moveString[6] = "0000", ponderString[6];
+	if (result.bestMove.data)
+		moveToString(result.bestMove, moveString);
+	if (result.pvLength > 1)
+	{
+		moveToString(result.pv[1], ponderString);
+		printf("bestmove %s ponder %s\n", moveString, ponderString);
+	}
+	else
+		printf("bestmove %s\n", moveString);
+}
+
+void uciStopSearch()
+{
+	// Stops the search in progress, if there is one, and waits for it to give its move
+	if (uciSearchThread.joinable())
+	{
+		uciStopRequested = 1;
+		stopSearch = 1;
+		uciSearchThread.join();
+	}
+}
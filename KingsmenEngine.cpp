@@ -0,0 +1,2647 @@
+/* ***********************KINGSMEN CHESS ENGINE***************************** */
+/* The engine's code; see KingsmenEngine.h.                                      */
+/* ***************************************************************************** */
+
+#include "KingsmenEngine.h"
+
+// namespaces
+using namespace std;
+
+
+// global variables
+zobristTablesClass zobristTables; // before any board in this file, since a board hashes itself when it is constructed
+transpositionTableClass transpositionTable;
+int hashSizeMB = 16; // size of the transposition table
+atomic<int> searchThreads(max(1, (int)thread::hardware_concurrency())); // threads the ai searches with (the window changes it mid-game)
+atomic<int> stopSearch(0); // set to 1 to make every search thread stop
+squareTablesClass squareTables;
+bitboardTablesClass bitboardTables;
+int moveGenBackend = 1; // which move generator (and attack test) to use: 0=mailbox, 1=bitboard
+
+// Move Offsets
+//	The following offsets can be added to a piece's location to generate a potential move location
+int pawnOffset[4]    = {9, 10, 11, 0};                        // For white these offsets should be made negative
+int knightOffset[9]  = {-21, -19, -8, -12, 19, 21, 8, 12, 0}; // These include all 8 possible space offsets for the knight 
+int bishopOffset[5]  = {-9, 9, -11, 11, 0};                   // Obviously there will be some repetition here to get a bishop moving more than one space 
+int rookOffset[5]    = {-10, 10, -1, 1, 0};                   // Similar to the bishop, these need to be repeated to get rooks moving more than one space 
+int queenOffset[9]   = {-9, 9, -11, 11, -10, 10, -1, 1, 0};   // Effectively Rook and Bishop combined 
+int kingOffset[9]    = {-9, 9, -11, 11, -10, 10, -1, 1, 0};   // Same as the queen, but don't repeat 
+
+const int boardClass::initialBoard[] = 
+	{-99, -99, -99, -99, -99, -99, -99, -99, -99, -99,
+	 -99, -99, -99, -99, -99, -99, -99, -99, -99, -99,
+	 -99,  -4,  -2,  -3,  -5,  -6,  -3,  -2,  -4, -99,
+	 -99,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1, -99,
+	 -99,   0,   0,   0,   0,   0,   0,   0,   0, -99,
+	 -99,   0,   0,   0,   0,   0,   0,   0,   0, -99,
+	 -99,   0,   0,   0,   0,   0,   0,   0,   0, -99,
+	 -99,   0,   0,   0,   0,   0,   0,   0,   0, -99,
+	 -99,   1,   1,   1,   1,   1,   1,   1,   1, -99,
+	 -99,   4,   2,   3,   5,   6,   3,   2,   4, -99,
+	 -99, -99, -99, -99, -99, -99, -99, -99, -99, -99,
+	 -99, -99, -99, -99, -99, -99, -99, -99, -99, -99 };
+
+// Square Tables
+const int squareTablesClass::pawnTable[120] = 
+	{
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1,  0,  0,  0,  0,  0,  0,  0,  0, -1,
+		-1, 50, 50, 50, 50, 50, 50, 50, 50, -1,
+		-1, 10, 10, 20, 30, 30, 20, 10, 10, -1,
+		-1,  5,  5, 10, 27, 27, 10,  5,  5, -1,
+		-1,  0,  0,  0, 25, 25,  0,  0,  0, -1,
+		-1,  5, -5,-10,  0,  0,-10, -5,  5, -1,
+		-1,  5, 10, 10,-25,-25, 10, 10,  5, -1,
+		-1,  0,  0,  0,  0,  0,  0,  0,  0, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+	};
+
+const int squareTablesClass::bishopTable[120] = 
+	{
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1,-20,-10,-10,-10,-10,-10,-10,-20, -1,
+		-1,-10,  0,  0,  0,  0,  0,  0,-10, -1,
+		-1,-10,  0,  5, 10, 10,  5,  0,-10, -1,
+		-1,-10,  5,  5, 10, 10,  5,  5,-10, -1,
+		-1,-10,  0, 10, 10, 10, 10,  0,-10, -1,
+		-1,-10, 10, 10, 10, 10, 10, 10,-10, -1,
+		-1,-10,  5,  0,  0,  0,  0,  5,-10, -1,
+		-1,-20,-10,-40,-10,-10,-40,-10,-20, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+	};
+
+const int squareTablesClass::knightTable[120] = 
+	{
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1,-50,-40,-30,-30,-30,-30,-40,-50, -1,
+		-1,-40,-20,  0,  0,  0,  0,-20,-40, -1,
+		-1,-30,  0, 10, 15, 15, 10,  0,-30, -1,
+		-1,-30,  5, 15, 20, 20, 15,  5,-30, -1,
+		-1,-30,  0, 15, 20, 20, 15,  0,-30, -1,
+		-1,-30,  5, 10, 15, 15, 10,  5,-30, -1,
+		-1,-40,-20,  0,  5,  5,  0,-20,-40, -1,
+		-1,-50,-40,-20,-30,-30,-20,-40,-50, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+	};
+
+const int squareTablesClass::kingTableMid[120] = 
+	{
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1,-30,-40,-40,-50,-50,-40,-40,-30, -1,
+		-1,-30,-40,-40,-50,-50,-40,-40,-30, -1,
+		-1,-30,-40,-40,-50,-50,-40,-40,-30, -1,
+		-1,-30,-40,-40,-50,-50,-40,-40,-30, -1,
+		-1,-20,-30,-30,-40,-40,-30,-30,-20, -1,
+		-1,-10,-20,-20,-20,-20,-20,-20,-10, -1,
+		-1, 20, 20,  0,  0,  0,  0, 20, 20, -1,
+		-1, 20, 30, 10,  0,  0, 10, 30, 20, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+	}; 
+
+const int squareTablesClass::kingTableEnd[120] =
+	{
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1,-50,-40,-30,-20,-20,-30,-40,-50, -1,
+		-1,-30,-20,-10,  0,  0,-10,-20,-30, -1,
+		-1,-30,-10, 20, 30, 30, 20,-10,-30, -1,
+		-1,-30,-10, 30, 40, 40, 30,-10,-30, -1,
+		-1,-30,-10, 30, 40, 40, 30,-10,-30, -1,
+		-1,-30,-10, 20, 30, 30, 20,-10,-30, -1,
+		-1,-30,-30,  0,  0,  0,  0,-30,-30, -1,
+		-1,-50,-30,-30,-30,-30,-30,-30,-50, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+	};
+
+
+// Magic Numbers
+const bitboard bitboardTablesClass::knownBishopMagic[64] = 
+	{
+	0x40106000A1160020ULL, 0x0002080808A08080ULL, 0x0218248102100000ULL, 0x0008049300860080ULL,
+	0x000410A812000018ULL, 0x001A019420080008ULL, 0x0809041002081402ULL, 0x000080C41A200A00ULL,
+	0x9883210204010C04ULL, 0x1404045142141500ULL, 0x1200040810890800ULL, 0x0C80880861040200ULL,
+	0x4223040420200384ULL, 0x0800809004210013ULL, 0x0306014A0650C01CULL, 0x8000014C04042E00ULL,
+	0x1140881084080090ULL, 0x9011022401080500ULL, 0x07180004464D0200ULL, 0x0602002020224104ULL,
+	0xA104011080A04080ULL, 0x0082000840422001ULL, 0x0004500201100802ULL, 0x200100C080611010ULL,
+	0x120404804008280AULL, 0x04021002C2648810ULL, 0x0100410030040084ULL, 0x8202028068008022ULL,
+	0x0014082004002000ULL, 0x0300810080806004ULL, 0x009404118108C200ULL, 0x0814029300248402ULL,
+	0xC00108C8C0405014ULL, 0xC041180290201430ULL, 0x1005080110260400ULL, 0x0849040108240100ULL,
+	0x05004200210A0080ULL, 0x0828C08100220100ULL, 0x00100102018100C0ULL, 0x8048008020008206ULL,
+	0xC0080A0321045041ULL, 0x800084040220200AULL, 0x4404101804064800ULL, 0x2000420202000420ULL,
+	0x300C01A011000200ULL, 0x010408A882010100ULL, 0x80201404005110A8ULL, 0x0010440129400420ULL,
+	0x0011088805402400ULL, 0x00208401211102B0ULL, 0x0000030488048088ULL, 0x0000042020A80200ULL,
+	0x03080104050C0000ULL, 0x0685115610030012ULL, 0x0088101008D10424ULL, 0x4020120A40450080ULL,
+	0x0001040201040290ULL, 0x0840020062021011ULL, 0x0004221D02415001ULL, 0x0082021430840420ULL,
+	0x0000400704209204ULL, 0x0100081020011104ULL, 0x0288903090010047ULL, 0x0020040482041560ULL
+	};
+
+const bitboard bitboardTablesClass::knownRookMagic[64] = 
+	{
+	0x0A80004000801220ULL, 0x10C0100040002000ULL, 0x0100102000410009ULL, 0x0B0021000C100008ULL,
+	0x4080080080040002ULL, 0x0200019004080200ULL, 0x0400080A10112684ULL, 0x20800A4D00062080ULL,
+	0x2091800020804000ULL, 0x0044401000200040ULL, 0x1001002000401108ULL, 0x1001800801100081ULL,
+	0x0001000500080010ULL, 0x1000808002000400ULL, 0x0404000482100108ULL, 0x0003000182610002ULL,
+	0x0440848002C00420ULL, 0x2010890040010021ULL, 0x8800110020044300ULL, 0x0208010100201000ULL,
+	0x1222020004102008ULL, 0x4002010100040008ULL, 0x0880040002880110ULL, 0x0A601A0001008044ULL,
+	0x0041288780044004ULL, 0x0000400100210080ULL, 0x2420002080100080ULL, 0x2004422200120008ULL,
+	0x4964018080050800ULL, 0x2830020080040080ULL, 0x220C870400304218ULL, 0x601200420004A411ULL,
+	0x1100824001800030ULL, 0x1010104000402000ULL, 0x0011802001801008ULL, 0x0210040040400800ULL,
+	0x0400110005000800ULL, 0x0802010402000810ULL, 0x14A0800200800100ULL, 0x0441801060800100ULL,
+	0x4404708140008001ULL, 0x0000500120014000ULL, 0x0000200300430010ULL, 0x0045001000250008ULL,
+	0x0000040008008080ULL, 0x0000040002008080ULL, 0x010018210A0C0090ULL, 0x90000900408A000CULL,
+	0x0408CC2380010100ULL, 0x0010400900208100ULL, 0x0820004611022100ULL, 0x0000100008008080ULL,
+	0x2014050010080100ULL, 0x0102020004008080ULL, 0x8010421021080400ULL, 0x1006004084110200ULL,
+	0x0080082100429083ULL, 0x104C201081004001ULL, 0x2400081100402001ULL, 0x00A0040820100101ULL,
+	0x0022000820041002ULL, 0x0A61000400080201ULL, 0x060008022100D004ULL, 0x4040054084002B02ULL
+	};
+
+bitboardTablesClass::bitboardTablesClass()
+{
+	// The tables are built by walking the 120 square board with the usual move offsets, which already
+	//	takes care of the board edges for us.
+
+	int sq, from, to, j, multiple;
+	int directionOffset[8] = {bishopOffset[0], bishopOffset[1], bishopOffset[2], bishopOffset[3],
+							  rookOffset[0],   rookOffset[1],   rookOffset[2],   rookOffset[3]};
+
+	for (sq=0; sq<64; sq++)
+	{
+		from = sq64To120[sq];
+
+		knightAttacks[sq] = 0;
+		for (j=0; knightOffset[j] != 0; j++)
+			if (sq120To64[from + knightOffset[j]] != -1)
+				knightAttacks[sq] |= 1ULL << sq120To64[from + knightOffset[j]];
+
+		kingAttacks[sq] = 0;
+		for (j=0; kingOffset[j] != 0; j++)
+			if (sq120To64[from + kingOffset[j]] != -1)
+				kingAttacks[sq] |= 1ULL << sq120To64[from + kingOffset[j]];
+
+		pawnAttacks[0][sq] = 0;
+		pawnAttacks[1][sq] = 0;
+		for (j=0; j<2; j++)
+		{
+			if (sq120To64[from - pawnOffset[2*j]] != -1) // white pawns capture towards the 8th rank
+				pawnAttacks[0][sq] |= 1ULL << sq120To64[from - pawnOffset[2*j]];
+			if (sq120To64[from + pawnOffset[2*j]] != -1)
+				pawnAttacks[1][sq] |= 1ULL << sq120To64[from + pawnOffset[2*j]];
+		}
+
+		for (j=0; j<8; j++)
+		{
+			rays[j][sq] = 0;
+			for (multiple=1; (to = sq120To64[from + directionOffset[j]*multiple]) != -1; multiple++)
+				rays[j][sq] |= 1ULL << to;
+		}
+	}
+
+	for (j=0; j<8; j++)
+		rayIncreasing[j] = sq120To64[55 + directionOffset[j]] > sq120To64[55];
+
+	// Squares between: everything along the ray from the first square that isn't on the ray from the second
+	memset(between, 0, sizeof(between));
+	for (sq=0; sq<64; sq++)
+		for (j=0; j<8; j++)
+			for (bitboard ray = rays[j][sq]; ray; )
+			{
+				to = popLowestBit(ray);
+				between[sq][to] = rays[j][sq] & ~rays[j][to] & ~(1ULL << to);
+			}
+
+	// Sliding attack tables
+	int bishopTableSize = 0, rookTableSize = 0;
+	for (sq=0; sq<64; sq++)
+	{
+		initializeSliderTable(sq, 1, bishopTableSize);
+		initializeSliderTable(sq, 0, rookTableSize);
+	}
+}
+
+bitboard bitboardTablesClass::rayAttacks(int square, bitboard occupied, int firstDirection, int lastDirection) const
+{
+	// Squares attacked by a slider on the given square (0-63) along the given ray directions, found by 
+	//	cutting each ray off just past the first occupied square on it. Only used to fill in the lookup
+	//	tables.
+
+	bitboard attacks = 0, blockers;
+
+	for (int j=firstDirection; j<=lastDirection; j++)
+	{
+		attacks |= rays[j][square];
+		blockers = rays[j][square] & occupied;
+		if (blockers)
+		{
+			int blocker = rayIncreasing[j] ? bitScanForward(blockers) : bitScanReverse(blockers);
+			attacks &= ~rays[j][blocker];
+		}
+	}
+
+	return attacks;
+}
+
+void bitboardTablesClass::initializeSliderTable(int square, int bishop, int &tableStart)
+{
+	// Fills in the mask, magic, shift and attack table slice for a bishop (bishop=1) or rook (bishop=0)
+	//	on the given square. tableStart is where this square's slice begins and is advanced past it.
+
+	static bitboard occupancies[4096], attacks[4096];
+	static int usedInAttempt[4096], attempt = 0;
+	int firstDirection = bishop ? 0 : 4;
+	int i, j, size;
+
+	// The mask: every square along the slider's rays except the last one on each, since a piece on 
+	//	the board edge can't block anything further
+	bitboard mask = 0;
+	for (j=firstDirection; j<firstDirection+4; j++)
+		if (rays[j][square])
+			mask |= rays[j][square] & ~(1ULL << (rayIncreasing[j] ? bitScanReverse(rays[j][square]) : bitScanForward(rays[j][square])));
+	int bits = popCount(mask);
+
+	// Every subset of the mask along with the attacks it produces
+	bitboard subset = 0;
+	size = 0;
+	do
+	{
+		occupancies[size] = subset;
+		attacks[size]     = rayAttacks(square, subset, firstDirection, firstDirection+3);
+		size++;
+		subset = (subset - mask) & mask;
+	} while (subset);
+
+	bitboard *table = bishop ? bishopTable : rookTable;
+	bitboard magic  = 0;
+
+#ifdef __BMI2__
+	for (i=0; i<size; i++)
+		table[tableStart + _pext_u64(occupancies[i], mask)] = attacks[i];
+#else
+	// Find a magic number: one that sends every subset to an entry that either is unused or holds
+	//	the same attacks. We try the known magic first and only search if it doesn't work out; sparse
+	//	random numbers find one eventually. The seed is fixed so that every run builds the same tables.
+	static unsigned long long seed = 728;
+	int found = 0;
+	for (int tries=0; !found; tries++)
+	{
+		if (tries == 0)
+			magic = bishop ? knownBishopMagic[square] : knownRookMagic[square];
+		else
+		{
+			magic = ~0ULL;
+			for (j=0; j<3; j++)
+			{
+				seed ^= seed >> 12; seed ^= seed << 25; seed ^= seed >> 27; // xorshift
+				magic &= seed * 2685821657736338717ULL;
+			}
+			if (popCount((mask * magic) & 0xFF00000000000000ULL) < 6)
+				continue;
+		}
+
+		attempt++; // entries not marked with this attempt's number are unused
+		for (found=1, i=0; i<size && found; i++)
+		{
+			int index = (int)((occupancies[i] * magic) >> (64 - bits));
+			if (usedInAttempt[index] != attempt)
+			{
+				usedInAttempt[index] = attempt;
+				table[tableStart + index] = attacks[i];
+			}
+			else if (table[tableStart + index] != attacks[i])
+				found = 0;
+		}
+	}
+#endif
+
+	if (bishop)
+	{
+		bishopMask[square] = mask;
+		bishopMagic[square] = magic;
+		bishopShift[square] = 64 - bits;
+		bishopTableStart[square] = tableStart;
+	}
+	else
+	{
+		rookMask[square] = mask;
+		rookMagic[square] = magic;
+		rookShift[square] = 64 - bits;
+		rookTableStart[square] = tableStart;
+	}
+	tableStart += size;
+}
+
+void boardClass::syncFromPieceLists()
+{
+	for (int i=0; i<120; i++)
+		pieceIndexAt[i] = -1;
+	for (int c=0; c<2; c++)
+	{
+		colorBB[c] = 0;
+		for (int i=0; i<7; i++)
+			pieceBB[c][i] = 0;
+	}
+	for (int i=0; i<16; i++)
+	{
+		if (whitePieceList[i].location)
+		{
+			pieceIndexAt[whitePieceList[i].location] = i;
+			pieceBB[0][whitePieceList[i].identity] |= 1ULL << sq120To64[whitePieceList[i].location];
+			colorBB[0] |= 1ULL << sq120To64[whitePieceList[i].location];
+		}
+		if (blackPieceList[i].location)
+		{
+			pieceIndexAt[blackPieceList[i].location] = i;
+			pieceBB[1][blackPieceList[i].identity] |= 1ULL << sq120To64[blackPieceList[i].location];
+			colorBB[1] |= 1ULL << sq120To64[blackPieceList[i].location];
+		}
+	}
+	hashKey = computeHashKey(*this);
+	positional = computePositionalScore(*this);
+}
+
+void displayBoardText(const int board[120])
+{
+     int i, j;
+     
+	 //for (i=0; i<40; i++)
+	 //    printf("\n\n");
+     
+     int row = 8, column = 1;
+     
+     printf("                                 ___________________\n");
+     for (i=2; i<=9; i++){
+         printf("                               %d | ", row);
+         row--;         
+     for (j=1; j<=8; j++){
+         if (board[10*i + j] == 0)
+            printf("%c%c", '-', ' ');
+         
+         if (board[10*i + j] == 1)
+            printf("%c%c", 'P', ' ');
+         if (board[10*i + j] == 2)
+            printf("%c%c", 'N', ' ');
+         if (board[10*i + j] == 3)
+            printf("%c%c", 'B', ' ');
+         if (board[10*i + j] == 4)
+            printf("%c%c", 'R', ' ');
+         if (board[10*i + j] == 5)
+            printf("%c%c", 'Q', ' ');
+         if (board[10*i + j] == 6)
+            printf("%c%c", 'K', ' ');
+            
+         if (board[10*i + j] == -1)
+            printf("%c%c", 'p', ' ');
+         if (board[10*i + j] == -2)
+            printf("%c%c", 'n', ' ');
+         if (board[10*i + j] == -3)
+            printf("%c%c", 'b', ' ');
+         if (board[10*i + j] == -4)
+            printf("%c%c", 'r', ' ');
+         if (board[10*i + j] == -5)
+            printf("%c%c", 'q', ' ');
+         if (board[10*i + j] == -6)
+            printf("%c%c", 'k', ' ');
+     }
+         printf("|\n");
+     
+     }   
+     printf("                                 -------------------\n");
+     printf("                                   a b c d e f g h\n");
+}
+
+void initializePieceList(pieceClass pieceList[16], int player)
+{
+	// This function will initialize a list of pieces for one of the players (player==1 is white, 
+	//	player==2 is black).
+	//
+	// Recall:
+	// entry[i] = 
+    //             0 - king          8 - a pawn
+    //             1 - queen         9 - b pawn
+    //             2 - a rook        10 - c pawn
+    //             3 - h rook        11 - d pawn
+    //             4 - c bishop      12 - e pawn
+    //             5 - f bishop      13 - f pawn 
+    //             6 - b knight      14 - g pawn
+    //             7 - g knight      15 - h pawn
+
+	if (player==1) // White pieces
+	{
+		pieceList[0].initializePiece(6, 0,    95, 0, 1, 0); // king
+		pieceList[1].initializePiece(5, 1050, 94, 0, 1, 1); // queen
+		pieceList[2].initializePiece(4, 540,  91, 0, 1, 2); // a rook
+		pieceList[3].initializePiece(4, 540,  98, 0, 1, 3); // h rook
+		pieceList[4].initializePiece(3, 335,  93, 0, 1, 4); // c bishop
+		pieceList[5].initializePiece(3, 335,  96, 0, 1, 5); // f bishop
+		pieceList[6].initializePiece(2, 325,  92, 0, 1, 6); // b knight
+		pieceList[7].initializePiece(2, 325,  97, 0, 1, 7); // g knight
+		pieceList[8].initializePiece(1, 100,  81, 0, 1, 8); // pawn
+		pieceList[9].initializePiece(1, 100,  82, 0, 1, 9); // pawn
+		pieceList[10].initializePiece(1, 100,  83, 0, 1, 10); // pawn
+		pieceList[11].initializePiece(1, 100,  84, 0, 1, 11); // pawn
+		pieceList[12].initializePiece(1, 100,  85, 0, 1, 12); // pawn
+		pieceList[13].initializePiece(1, 100,  86, 0, 1, 13); // pawn
+		pieceList[14].initializePiece(1, 100,  87, 0, 1, 14); // pawn
+		pieceList[15].initializePiece(1, 100,  88, 0, 1, 15); // pawn
+	}
+
+	else if (player==2) // Black pieces
+	{
+		pieceList[0].initializePiece(6, 0,    25, 0, -1, 0); // king
+		pieceList[1].initializePiece(5, 1050, 24, 0, -1, 1); // queen
+		pieceList[2].initializePiece(4, 540,  21, 0, -1, 2); // a rook
+		pieceList[3].initializePiece(4, 540,  28, 0, -1, 3); // h rook
+		pieceList[4].initializePiece(3, 335,  23, 0, -1, 4); // c bishop
+		pieceList[5].initializePiece(3, 335,  26, 0, -1, 5); // f bishop
+		pieceList[6].initializePiece(2, 325,  22, 0, -1, 6); // b knight
+		pieceList[7].initializePiece(2, 325,  27, 0, -1, 7); // g knight
+		pieceList[8].initializePiece(1, 100,  31, 0, -1, 8); // pawn
+		pieceList[9].initializePiece(1, 100,  32, 0, -1, 9); // pawn
+		pieceList[10].initializePiece(1, 100, 33, 0, -1, 10); // pawn
+		pieceList[11].initializePiece(1, 100, 34, 0, -1, 11); // pawn
+		pieceList[12].initializePiece(1, 100, 35, 0, -1, 12); // pawn
+		pieceList[13].initializePiece(1, 100, 36, 0, -1, 13); // pawn
+		pieceList[14].initializePiece(1, 100, 37, 0, -1, 14); // pawn
+		pieceList[15].initializePiece(1, 100, 38, 0, -1, 15); // pawn
+	}
+
+	/*
+	int i;
+
+	// Initialize each piece's identity
+	pieceList[0].identity = 6; // king
+	pieceList[1].identity = 5; // queen
+	pieceList[2].identity = 4; // a rook
+	pieceList[3].identity = 4; // h rook
+	pieceList[4].identity = 3; // c bishop
+	pieceList[5].identity = 3; // f bishop
+	pieceList[6].identity = 2; // b knight
+	pieceList[7].identity = 2; // g knight
+	for (i=8; i<16; i++) {pieceList[i].identity = 1;} // pawns
+	
+	// Initialize each piece's value
+	pieceList[0].value = 0;		// king
+	pieceList[1].value = 1050;  // queen
+	pieceList[2].value = 540;   // a rook
+	pieceList[3].value = 540;   // h rook
+	pieceList[4].value = 335;   // c bishop
+	pieceList[5].value = 335;   // f bishop
+	pieceList[6].value = 325;   // b knight
+	pieceList[7].value = 325;   // g knight
+	for (i=8; i<16; i++){pieceList[i].value = 100;} // pawns
+
+	// Initialize each piece's location
+	if (player==1) // white
+	{
+		pieceList[0].location = 95; // king
+		pieceList[1].location = 94; // queen
+		pieceList[2].location = 91; // a rook
+		pieceList[3].location = 98; // h rook
+		pieceList[4].location = 93; // c bishop
+		pieceList[5].location = 96; // f bishop
+		pieceList[6].location = 92; // b knight
+		pieceList[7].location = 97; // g knight
+		for (i=8; i<16; i++) {pieceList[i].location = 73+i;}; // pawn
+	}
+	else if (player==2) // black
+	{
+		pieceList[0].location = 25; // king
+		pieceList[1].location = 24; // queen
+		pieceList[2].location = 21; // a rook
+		pieceList[3].location = 28; // h rook
+		pieceList[4].location = 23; // c bishop
+		pieceList[5].location = 26; // f bishop
+		pieceList[6].location = 22; // b knight
+		pieceList[7].location = 27; // g knight
+		for (i=8; i<16; i++) {pieceList[i].location = 23+i;}; // pawn
+	}
+
+	// Initialize each piece's 'everMoved' status
+	for (i=0; i<16; i++){
+		pieceList[i].everMoved = 0;
+	}
+	*/
+}
+
+int generatePseudoLegalMoveList(const boardClass &board, moveListClass &legalMoveList, int player)
+{
+	// Generates the pseudo legal moves for the player (1=white, -1=black) with whichever move generator
+	//	is selected by moveGenBackend. Both generators give the same moves, though not in the same order.
+
+	if (moveGenBackend == 1)
+		return generateMoveListBitboard(board, legalMoveList, player, ~board.colorBB[player == 1 ? 0 : 1], 1, 1);
+	else
+		return generatePseudoLegalMoveListMailbox(board, legalMoveList, player);
+}
+
+int generateCaptureMoveList(const boardClass &board, moveListClass &moveList, int player)
+{
+	// Generates only the pseudo legal captures and promotions of the player (1=white, -1=black), for the
+	//	quiescence search. The mailbox generator has no captures-only mode, so with it we generate
+	//	everything and drop the quiet moves.
+
+	if (moveGenBackend == 1)
+		return generateMoveListBitboard(board, moveList, player, board.colorBB[player == 1 ? 1 : 0], 1, 0);
+
+	generatePseudoLegalMoveListMailbox(board, moveList, player);
+	for (int i=moveList.size()-1; i>=0; i--)
+		if (!isCaptureOrPromotion(board, moveList[i]))
+			moveList.remove(i);
+	return moveList.size();
+}
+
+int generateQuietMoveList(const boardClass &board, moveListClass &moveList, int player)
+{
+	// Generates the pseudo legal moves of the player (1=white, -1=black) that generateCaptureMoveList()
+	//	leaves out, i.e. everything that isn't a capture or a promotion.
+
+	if (moveGenBackend == 1)
+		return generateMoveListBitboard(board, moveList, player, ~(board.colorBB[0] | board.colorBB[1]), 0, 1);
+
+	generatePseudoLegalMoveListMailbox(board, moveList, player);
+	for (int i=moveList.size()-1; i>=0; i--)
+		if (isCaptureOrPromotion(board, moveList[i]))
+			moveList.remove(i);
+	return moveList.size();
+}
+
+int isPseudoLegalMove(const boardClass &board, moveStruct move)
+{
+	// Returns 1 if the move is one the move generator would give for the player to move in this position,
+	//	without generating any moves in the common cases. Used to check moves remembered from other
+	//	positions (the hash move, killer moves) before trying them.
+
+	int from   = getMoveFrom(move);
+	int to     = getMoveTo(move);
+	int flags  = getMoveFlags(move);
+	int player = board.sideToMove();
+
+	if (move.data == 0 || sgn(board.board[from]) != player || board.board[to] == -99 || sgn(board.board[to]) == player)
+		return 0;
+
+	int identity = board.board[from]*player;
+	bitboard occupied = board.colorBB[0] | board.colorBB[1];
+	int toRow = to/10;
+	if (identity == 1 && flags == normalMove && toRow != 2 && toRow != 9)
+	{
+		if (to == from - 10*player)
+			return board.board[to] == 0;
+		if (to == from - 9*player || to == from - 11*player)
+			return sgn(board.board[to]) == -player;
+		return 0;
+	}
+	if (identity == 1 && flags == doublePawnPush)
+		return from/10 == (player == 1 ? 8 : 3) && to == from - 20*player && board.board[from - 10*player] == 0 && board.board[to] == 0;
+	if (identity != 1 && flags == normalMove)
+	{
+		bitboard attacks = 0;
+		if (identity == 2) attacks = bitboardTables.knightAttacks[sq120To64[from]];
+		if (identity == 3) attacks = bishopAttacks(sq120To64[from], occupied);
+		if (identity == 4) attacks = rookAttacks(sq120To64[from], occupied);
+		if (identity == 5) attacks = bishopAttacks(sq120To64[from], occupied) | rookAttacks(sq120To64[from], occupied);
+		if (identity == 6) attacks = bitboardTables.kingAttacks[sq120To64[from]];
+		return (attacks >> sq120To64[to]) & 1;
+	}
+
+	// Castling, en passant and promotions are rare enough that we just look for them in the move list
+	moveListClass moveList;
+	generatePseudoLegalMoveList(board, moveList, player);
+	for (int i=0; i<moveList.size(); i++)
+		if (moveList[i].data == move.data)
+			return 1;
+	return 0;
+}
+
+int isCaptureOrPromotion(const boardClass &board, moveStruct move)
+{
+	// Returns 1 for moves that change the material on the board, 0 for quiet moves
+	return board.board[getMoveTo(move)] != 0 || getMoveFlags(move) == enPassantCapture || (getMoveFlags(move) & promotion);
+}
+
+int generatePseudoLegalMoveListMailbox(
+	const boardClass   &board, 
+	moveListClass &legalMoveList, 
+	int                player)
+{
+	// This function generates a list of all the legal moves for the given player (1=white,
+	//	-1=black). The returned value is the number of legal moves found.
+
+	const pieceClass *pieceList = board.getPieceList(player);
+
+	// Initialize some useful values
+	int i,j;
+	int numLegalMoves = 0;
+	int potentialMoveTo;
+	int pathClear, multiple;
+
+	// Clear our the current legal move list
+	legalMoveList.clear();
+
+	/* Let's loop through our 16 pieces and come up with a legal move set, shall we */
+    for (i=0; i<16; i++){
+
+		if (pieceList[i].location == 0); // If the piece has been captured it can't possibly 
+										  //	give us any legal moves
+
+		else if (pieceList[i].identity == 1) // pawn
+		{
+			// Check to see if a piece is directly in front of the pawn.
+			//	If not, it is listed in the legal moves list.
+			potentialMoveTo = pieceList[i].location - 10*player;
+			if (board.board[potentialMoveTo] == 0)
+			{
+				numLegalMoves += addPawnMove(legalMoveList, pieceList[i].location, potentialMoveTo);
+
+				// Now let's see if that pawn can also move two spaces ahead.
+				if (pieceList[i].everMoved == 0) // If the pawn has never moved before,
+				{
+					potentialMoveTo = pieceList[i].location - 20*player;
+					if (board.board[potentialMoveTo] == 0) // and if there is no piece at the target square
+					{
+						legalMoveList.add(makeMoveStruct(pieceList[i].location, potentialMoveTo, doublePawnPush));
+						numLegalMoves++;
+					}
+				}
+			}
+
+			// Next we see if there is an opposing piece diagonally in front of the pawn.
+			//	If there is, we add it that move to the legal moves list.
+			potentialMoveTo = pieceList[i].location - 9*player;
+			if (board.board[potentialMoveTo] != -99){ // If we're not moving off the board
+				if (sgn(board.board[potentialMoveTo]) == -sgn(player)){ // and if we're capturing our opponent's piece
+					numLegalMoves += addPawnMove(legalMoveList, pieceList[i].location, potentialMoveTo);
+				}
+			}
+
+			potentialMoveTo = pieceList[i].location - 11*player;
+			if (board.board[potentialMoveTo] != -99){ // If we're not moving off the board
+				if (sgn(board.board[potentialMoveTo]) == -sgn(player)){ // and if we're capturing an opponent's piece
+					numLegalMoves += addPawnMove(legalMoveList, pieceList[i].location, potentialMoveTo);
+				}
+			}
+
+			// Finally, en passant: if the opponent's last move was a pawn pushed two squares to right
+			//	beside this pawn, we may capture it by moving to the square it skipped over.
+			if (board.epSq != 0 && (pieceList[i].location == board.epSq - 1 || pieceList[i].location == board.epSq + 1))
+			{
+				legalMoveList.add(makeMoveStruct(pieceList[i].location, board.epSq - 10*player, enPassantCapture));
+				numLegalMoves++;
+			}
+		}
+
+		else if (pieceList[i].identity == 2) // knight
+		{
+			for (j=0; knightOffset[j] != 0; j++)
+			{
+				potentialMoveTo = pieceList[i].location + knightOffset[j];
+				if (board.board[potentialMoveTo] != -99){ // If the move is not off the board,
+					if (sgn(board.board[potentialMoveTo]) != sgn(player)){ // and if we're not capturing our own piece
+						legalMoveList.add(makeMoveStruct(pieceList[i].location, potentialMoveTo));
+						numLegalMoves++;
+					}
+				}
+			}  
+		}
+
+		else if (pieceList[i].identity == 3) // bishop
+		{
+			for (j=0; bishopOffset[j] != 0; j++)
+			{
+				pathClear = 1;
+				for (multiple=1; pathClear; multiple++) // Loop through all the different directions, as stored in the offset
+				{
+					pathClear = 0; // Start with the assumption that there are no further moves until proven wrong
+					potentialMoveTo = pieceList[i].location + bishopOffset[j]*multiple;
+					if (board.board[potentialMoveTo] != -99){ // If the move isn't off the board,
+						if ( sgn(board.board[potentialMoveTo]) != sgn(player)){ // and we aren't capturing our own piece
+							legalMoveList.add(makeMoveStruct(pieceList[i].location, potentialMoveTo));
+							numLegalMoves++;
+						}
+
+						if (board.board[potentialMoveTo] == 0) // If we're moving to an empty square the bishop can potentially move forward even more
+							pathClear = 1;
+					}
+				}
+			}
+		}
+
+		else if (pieceList[i].identity == 4) // rook
+		{
+			for (j=0; rookOffset[j] != 0; j++)
+			{
+				pathClear = 1;
+				for (multiple=1; pathClear; multiple++)
+				{
+					pathClear = 0;
+					potentialMoveTo = pieceList[i].location + rookOffset[j]*multiple;
+					if (board.board[potentialMoveTo] != -99){ // If the move isn't off the board,
+						if (sgn(board.board[potentialMoveTo]) != sgn(player)){ // and we aren't capturing our own piece
+							legalMoveList.add(makeMoveStruct(pieceList[i].location, potentialMoveTo));
+							numLegalMoves++;
+						}
+
+						if (board.board[potentialMoveTo] == 0) // If we're moving to an empty square the rook can potentially move forward further
+							pathClear = 1;
+
+					}
+				}
+			}
+		}
+
+		else if (pieceList[i].identity == 5) // queen
+		{
+			for (j=0; queenOffset[j] != 0; j++)
+			{
+				pathClear = 1;
+				for (multiple=1; pathClear; multiple++)
+				{
+					pathClear = 0;
+					potentialMoveTo = pieceList[i].location + queenOffset[j]*multiple;
+					if (board.board[potentialMoveTo] != -99){ // If the move isn't off the board
+						if (sgn(board.board[potentialMoveTo]) != sgn(player)){ // and we aren't capturing our own piece
+							legalMoveList.add(makeMoveStruct(pieceList[i].location, potentialMoveTo));
+							numLegalMoves++;
+						}
+
+						if (board.board[potentialMoveTo] == 0) // If we're moving to an empty square the queen can potentially move forward further
+							pathClear = 1;
+					}
+				}
+			}
+		}
+
+		else if (pieceList[i].identity == 6) // king
+		{
+			for (j=0; kingOffset[j] !=- 0; j++)
+			{
+				potentialMoveTo = pieceList[i].location + kingOffset[j];
+				if (board.board[potentialMoveTo] != -99){ // If the move isn't off the board
+					if (sgn(board.board[potentialMoveTo]) != sgn(player)){ // and we aren't capturing our own piece
+						legalMoveList.add(makeMoveStruct(pieceList[i].location, potentialMoveTo));
+						numLegalMoves++;
+					}
+				}
+			}
+
+			// Castling
+			numLegalMoves += addCastlingMoves(board, legalMoveList, player);
+		}
+
+
+	}
+	return numLegalMoves;
+}
+
+int addCastlingMoves(const boardClass &board, moveListClass &legalMoveList, int player)
+{
+	// Adds the castling moves available to the player (1=white, -1=black) to the move list and returns
+	//	how many were added. Shared by both move generators.
+
+	const pieceClass *pieceList = board.getPieceList(player);
+	int potentialMoveTo;
+	int numLegalMoves = 0;
+
+	// Note: the king may not castle out of or through check; the square it lands on is checked
+	//	along with every other move by generateFullLegalMoveList()
+	if (pieceList[0].everMoved == 0 && !isSquareAttacked(board, pieceList[0].location, -player)){ // if the king has never moved and is not in check
+		// Check castling with the a-file rook
+		potentialMoveTo = pieceList[0].location - 2;
+		if (pieceList[2].everMoved==0 && pieceList[2].location==pieceList[0].location-4){ // if the a-file rook has never moved and still exists
+			if (board.board[pieceList[0].location-1]==0 && board.board[pieceList[0].location-2]==0 && board.board[pieceList[0].location-3]==0){ // and if all the squares b/w 
+																											 //  the king and rook are empty
+				if (!isSquareAttacked(board, pieceList[0].location-1, -player)){ // and the king doesn't pass through check
+					legalMoveList.add(makeMoveStruct(pieceList[0].location, potentialMoveTo, queensideCastle));
+					numLegalMoves++;
+				}
+			}
+		}
+
+		// Check castling with the h-file rook
+		potentialMoveTo = pieceList[0].location + 2;
+		if (pieceList[3].everMoved==0 && pieceList[3].location==pieceList[0].location+3){ // if the h-file rook has never moved and still exists
+			if (board.board[pieceList[0].location+1]==0 && board.board[pieceList[0].location+2]==0){ // and if all the spaces b/w the king and rook are empty
+				if (!isSquareAttacked(board, pieceList[0].location+1, -player)){ // and the king doesn't pass through check
+					legalMoveList.add(makeMoveStruct(pieceList[0].location, potentialMoveTo, kingsideCastle));
+					numLegalMoves++;
+				}
+			}
+		}
+	}
+
+	return numLegalMoves;
+}
+
+int addPawnMove(moveListClass &legalMoveList, int from, int to)
+{
+	// Adds a pawn move to the move list and returns how many moves were added. A pawn reaching the
+	//	last rank must promote, so there it is added four times, once for each piece it can become.
+	//	Shared by both move generators.
+
+	if (to/10 == 2 || to/10 == 9) // 8th or 1st rank
+	{
+		for (int identity=5; identity>=2; identity--) // queen first
+			legalMoveList.add(makeMoveStruct(from, to, promotion + identity - 2));
+		return 4;
+	}
+
+	legalMoveList.add(makeMoveStruct(from, to));
+	return 1;
+}
+
+int generateFullLegalMoveList(
+	boardClass         &board, 
+	moveListClass &legalMoveList)
+{
+	// This function is similar to generatePseudoLegalMoveList() except that it additionally
+	//	checks for moves that result in check for the moving side. Moves are generated for the
+	//	player whose turn it is on the board.
+	//
+	// The bitboard backend generates legal moves directly. The mailbox backend makes each pseudo legal
+	//	move and takes it off the list if it leaves the king in check.
+
+	if (moveGenBackend == 1)
+		return generateLegalMoveListBitboard(board, legalMoveList);
+
+	// Find the Pseudo legal moves
+	int numLegalMoves = generatePseudoLegalMoveList(board, legalMoveList, board.sideToMove());
+
+	// Make sure none of the moves end in check for the moving player
+	int check;
+	for (int i=0; i<numLegalMoves; i++)
+	{
+		makeMove(legalMoveList[i], board);
+		check = inCheck(board, !board.playersTurn); // note: makeMove() switched who's turn it actually is
+		undoMove(board);
+
+		if (check){ // This move resulted in check and should be taken off the legal move list
+			legalMoveList.remove(i);
+			numLegalMoves--;
+			i--;
+		}
+
+	}
+
+
+	numLegalMoves = legalMoveList.size();
+	return numLegalMoves;
+}
+
+void printLegalMoveList(const moveListClass &legalMoveList)
+{
+	int numLegalMoves = legalMoveList.size();
+	
+	int row, col;
+	char rowFrom,colFrom, rowTo,colTo;
+	char colVals[] = "abcdefgh";
+	char rowVals[] = "87654321";
+
+	printf("\n\tNumber of legal moves found: %d\n", numLegalMoves);
+	for (int i=0; i<numLegalMoves; i++)
+	{
+		row = getMoveFrom(legalMoveList[i]) / 10;
+		col = getMoveFrom(legalMoveList[i]) % 10;
+		rowFrom = rowVals[row-2];
+		colFrom = colVals[col-1];
+
+		row = getMoveTo(legalMoveList[i]) / 10;
+		col = getMoveTo(legalMoveList[i]) % 10;
+		rowTo = rowVals[row-2];
+		colTo = colVals[col-1];
+
+		printf("\t%d -> %d (%c%c -> %c%c)", getMoveFrom(legalMoveList[i]), getMoveTo(legalMoveList[i]), colFrom,rowFrom, colTo,rowTo);
+		if (getMoveFlags(legalMoveList[i]) & promotion)
+			printf(" =%c", " PNBRQK"[getPromotionIdentity(legalMoveList[i])]);
+		printf("\n");
+	}
+}
+
+void printPieceInfo(const pieceClass pieceList[16])
+{
+	// This function can be used to print the all the piece info for a particular player.
+	//	Hopefully this function will be useful during debugging.
+
+	int i;
+
+	printf("\tIndex - ID - Location - Value - Ever Moved\n");
+	for (i=0; i<16; i++)
+	{
+		printf("\t%5.1d - %2.1d - %8.1d - %5.1d - %10.1d\n", 
+			i,
+			pieceList[i].identity,
+			pieceList[i].location,
+			pieceList[i].value,
+			pieceList[i].everMoved);
+	}
+}
+
+void printDebugInfo(const boardClass &board)
+{
+	printf("\n\nDEBUG INFO\n");
+	displayBoardText(board.board);
+	printf("\n\tWhite piece info\n");
+	printPieceInfo(board.whitePieceList);
+	printf("\n\tBlack piece info\n");
+	printPieceInfo(board.blackPieceList);
+	printf("\n\tHash key: %016llX\n", board.hashKey);
+
+	char fen[maxFenLength];
+	writeFen(board, fen);
+	printf("\tFen: %s\n", fen);
+}
+
+void makeRandomMove(const moveListClass &legalMoveList, boardClass &board)
+{
+	// This function just takes a random move off the legalMoveList and implements it.
+	
+	int numLegalMoves = legalMoveList.size();
+	printf("\n\tNumber of legal moves: %d", numLegalMoves);
+	moveStruct chosenMove = legalMoveList[randomNumber(0,numLegalMoves-1)];
+	printf("\n\tChosen AI move: %d -> %d", getMoveFrom(chosenMove), getMoveTo(chosenMove));
+
+	makeMove(chosenMove, board);
+
+}
+
+int randomNumber(int min_value, int max_value)
+{
+    int number;
+    
+    /* initialize random generator */
+    srand ( time(NULL) );
+
+    /* generate random numbers */
+
+    /*Syntax*/
+    /*
+    To get a number between MINIMUM and MAXIMUM, use:
+    rand() % (MAXIMUM - MINUMIM + 1) + MINIMUM;
+    */
+  
+    number = rand() % (max_value - min_value + 1) + min_value;
+    
+    return number;
+}
+
+int inCheck(const boardClass &board, int playerToCheck)
+{
+	// This function checks whether or not the current board position. The returned int is 0 for not in check
+	//	and 1 for in check.
+	// Note: playerToCheck (1=white, 0=black) is the owner of the king to check whether or not it is in check.
+
+	if (playerToCheck) // white
+		return isSquareAttacked(board, board.whitePieceList[0].location, -1);
+	else // black
+		return isSquareAttacked(board, board.blackPieceList[0].location, 1);
+}
+
+int isSquareAttacked(const boardClass &board, int square, int byPlayer)
+{
+	// Returns 1 if any piece of byPlayer (1=white, -1=black) attacks the given square, 0 otherwise.
+
+	if (moveGenBackend == 1)
+		return isSquareAttackedBitboard(board, square, byPlayer);
+	else
+		return isSquareAttackedMailbox(board, square, byPlayer);
+}
+
+int isSquareAttackedMailbox(const boardClass &board, int square, int byPlayer)
+{
+	// Mailbox version of isSquareAttacked(). Rather than generating the attacker's moves we look outward from the square itself: a knight
+	//	offset that lands on an enemy knight, a bishop ray that first runs into an enemy bishop or 
+	//	queen, and so on.
+
+	int j, potentialAttacker, multiple;
+
+	// Pawns; a white pawn attacks the squares 9 and 11 below it, so look for it 9 and 11 above us
+	if (board.board[square + 9*byPlayer] == byPlayer || board.board[square + 11*byPlayer] == byPlayer)
+		return 1;
+
+	// Knights
+	for (j=0; knightOffset[j] != 0; j++)
+		if (board.board[square + knightOffset[j]] == 2*byPlayer)
+			return 1;
+
+	// King
+	for (j=0; kingOffset[j] != 0; j++)
+		if (board.board[square + kingOffset[j]] == 6*byPlayer)
+			return 1;
+
+	// Bishops and queens along the diagonals
+	for (j=0; bishopOffset[j] != 0; j++)
+	{
+		for (multiple=1; (potentialAttacker = board.board[square + bishopOffset[j]*multiple]) == 0; multiple++);
+		if (potentialAttacker == 3*byPlayer || potentialAttacker == 5*byPlayer)
+			return 1;
+	}
+
+	// Rooks and queens along the files and ranks
+	for (j=0; rookOffset[j] != 0; j++)
+	{
+		for (multiple=1; (potentialAttacker = board.board[square + rookOffset[j]*multiple]) == 0; multiple++);
+		if (potentialAttacker == 4*byPlayer || potentialAttacker == 5*byPlayer)
+			return 1;
+	}
+
+	return 0;
+}
+
+void makeMove(moveStruct move, boardClass &board)
+{
+	// This function serves to take a move and implement it, including updating the two piece lists and board.
+	//	Everything needed to take the move back is pushed onto the board's undo stack, so moves can be made
+	//	and undone to any depth.
+
+	int from  = getMoveFrom(move);
+	int to    = getMoveTo(move);
+	int flags = getMoveFlags(move);
+	int mover = sgn(board.board[from]);
+	pieceClass *moverList    = board.getPieceList(mover);
+	pieceClass *opponentList = board.getPieceList(-mover);
+
+	// Make room on the undo stack; in the (very) unlikely event of a game this long we forget the oldest move
+	if (board.undoCount == boardClass::maxUndoDepth)
+	{
+		memmove(board.undoStack, board.undoStack+1, (boardClass::maxUndoDepth-1)*sizeof(undoStruct));
+		board.undoCount--;
+	}
+	undoStruct &undo = board.undoStack[board.undoCount++];
+	undo.move = move;
+	undo.capturedPiece.initializePiece(0,0,0,0,0,0);
+	undo.castlingRook = -1;
+	undo.pastEpSq = board.epSq;
+	undo.pastHashKey = board.hashKey;
+	undo.pastPositional = board.positional;
+	if (board.epSq)
+		board.hashKey ^= zobristTables.epKeys[board.epSq%10 - 1];
+	board.epSq = 0;
+
+	int us = (mover == 1) ? 0 : 1;
+	bitboard fromToBB = (1ULL << sq120To64[from]) | (1ULL << sq120To64[to]);
+
+	// Update any piece being captured; en passant takes the pawn sitting behind the square moved to
+	int captureSquare = (flags == enPassantCapture) ? to + 10*mover : to;
+	int captured = board.pieceIndexAt[captureSquare];
+	int moving   = board.pieceIndexAt[from];
+
+	// Castling rights can only be lost when a king or a castling rook (slots 0, 2 and 3) moves or is captured
+	int castlingMayChange = (moving <= 3 && moving != 1) || captured == 2 || captured == 3;
+	int pastCastlingRights = castlingMayChange ? board.castlingRights() : 0;
+	if (captured != -1)
+	{
+		undo.capturedPiece = opponentList[captured];
+		board.material += mover*opponentList[captured].value;
+		opponentList[captured].location = 0;
+		board.pieceBB[!us][opponentList[captured].identity] ^= 1ULL << sq120To64[captureSquare];
+		board.colorBB[!us] ^= 1ULL << sq120To64[captureSquare];
+		board.hashKey ^= zobristTables.pieceKeys[!us][opponentList[captured].identity][sq120To64[captureSquare]];
+		board.positional -= squareTables.pieceSquare[!us][opponentList[captured].identity][captureSquare];
+		board.board[captureSquare] = 0;
+		board.pieceIndexAt[captureSquare] = -1;
+	}
+
+	// Update the moving piece
+	undo.pastEverMovedStatus = moverList[moving].everMoved;
+	moverList[moving].location = to;
+	moverList[moving].everMoved = 1;
+	board.pieceBB[us][moverList[moving].identity] ^= fromToBB;
+	board.colorBB[us] ^= fromToBB;
+	board.hashKey ^= zobristTables.pieceKeys[us][moverList[moving].identity][sq120To64[from]] ^
+					 zobristTables.pieceKeys[us][moverList[moving].identity][sq120To64[to]];
+	board.positional += squareTables.pieceSquare[us][moverList[moving].identity][to] -
+						squareTables.pieceSquare[us][moverList[moving].identity][from];
+
+	// Update the board
+	board.board[to]   = board.board[from];
+	board.board[from] = 0;
+	board.pieceIndexAt[to]   = moving;
+	board.pieceIndexAt[from] = -1;
+
+	// Handle the special moves
+	if (flags == doublePawnPush)
+	{
+		board.epSq = to;
+		board.hashKey ^= zobristTables.epKeys[to%10 - 1];
+	}
+	else if (flags == kingsideCastle || flags == queensideCastle)
+	{
+		// The king has just moved two squares, now we move the rook
+		//	(the a-file rook lives in slot 2, the h-file rook in slot 3)
+		int rook = (flags == kingsideCastle) ? 3 : 2;
+		bitboard rookFromToBB = (1ULL << sq120To64[moverList[rook].location]) | (1ULL << sq120To64[(from + to)/2]);
+		undo.castlingRook = rook;
+		undo.pastRookEverMoved = moverList[rook].everMoved;
+		board.hashKey ^= zobristTables.pieceKeys[us][4][sq120To64[moverList[rook].location]] ^
+						 zobristTables.pieceKeys[us][4][sq120To64[(from + to)/2]];
+		board.positional += squareTables.pieceSquare[us][4][(from + to)/2] - squareTables.pieceSquare[us][4][moverList[rook].location];
+		board.board[moverList[rook].location] = 0;
+		board.pieceIndexAt[moverList[rook].location] = -1;
+		moverList[rook].location = (from + to)/2;
+		moverList[rook].everMoved = 1;
+		board.board[moverList[rook].location] = 4*mover;
+		board.pieceIndexAt[moverList[rook].location] = rook;
+		board.pieceBB[us][4] ^= rookFromToBB;
+		board.colorBB[us] ^= rookFromToBB;
+	}
+	else if (flags & promotion)
+	{
+		// The pawn keeps its piece list slot and simply becomes the new piece
+		int identity = getPromotionIdentity(move);
+		moverList[moving].identity = identity;
+		moverList[moving].value = pieceValues[identity];
+		board.material += mover*(pieceValues[identity] - pieceValues[1]);
+		board.board[to] = identity*mover;
+		board.pieceBB[us][1] ^= 1ULL << sq120To64[to];
+		board.pieceBB[us][identity] ^= 1ULL << sq120To64[to];
+		board.hashKey ^= zobristTables.pieceKeys[us][1][sq120To64[to]] ^ zobristTables.pieceKeys[us][identity][sq120To64[to]];
+		board.positional += squareTables.pieceSquare[us][identity][to] - squareTables.pieceSquare[us][1][to];
+	}
+
+	if (castlingMayChange)
+		board.hashKey ^= zobristTables.castlingKeys[pastCastlingRights] ^ zobristTables.castlingKeys[board.castlingRights()];
+
+	// Update whose turn it is
+	board.playersTurn = !board.playersTurn;
+	board.hashKey ^= zobristTables.blackToMoveKey;
+
+	// In debug builds, make sure the incrementally updated hash key and positional score are what we'd
+	//	get from scratch
+	assert(board.hashKey == computeHashKey(board));
+	assert(board.positional == computePositionalScore(board));
+}
+
+int undoMove(boardClass &board)
+{
+	// This function takes back the most recent move on the board's undo stack.
+	//
+	// The return value of this function designates whether the undo move was successful (1) or not (0).
+
+	if (board.undoCount == 0) // Make sure there is a move to undo
+		return 0;
+
+	undoStruct &undo = board.undoStack[--board.undoCount];
+	int from  = getMoveFrom(undo.move);
+	int to    = getMoveTo(undo.move);
+	int flags = getMoveFlags(undo.move);
+	int mover = sgn(board.board[to]);
+	pieceClass *moverList    = board.getPieceList(mover);
+	pieceClass *opponentList = board.getPieceList(-mover);
+
+	int us = (mover == 1) ? 0 : 1;
+	bitboard fromToBB = (1ULL << sq120To64[from]) | (1ULL << sq120To64[to]);
+
+	// Move back the piece that moved, turning a promoted piece back into a pawn first
+	int moving = board.pieceIndexAt[to];
+	if (flags & promotion)
+	{
+		int identity = moverList[moving].identity;
+		moverList[moving].identity = 1;
+		moverList[moving].value = pieceValues[1];
+		board.material -= mover*(pieceValues[identity] - pieceValues[1]);
+		board.board[to] = mover;
+		board.pieceBB[us][identity] ^= 1ULL << sq120To64[to];
+		board.pieceBB[us][1] ^= 1ULL << sq120To64[to];
+	}
+	moverList[moving].location = from;
+	moverList[moving].everMoved = undo.pastEverMovedStatus;
+	board.pieceBB[us][moverList[moving].identity] ^= fromToBB;
+	board.colorBB[us] ^= fromToBB;
+
+	// Update the board
+	board.board[from] = board.board[to];
+	board.board[to]   = 0;
+	board.pieceIndexAt[from] = moving;
+	board.pieceIndexAt[to]   = -1;
+
+	// Put the castling rook back in its corner
+	if (undo.castlingRook != -1)
+	{
+		int rook = undo.castlingRook;
+		bitboard rookFromToBB = (1ULL << sq120To64[moverList[rook].location]) | (1ULL << sq120To64[(rook == 3) ? from+3 : from-4]);
+		board.board[moverList[rook].location] = 0;
+		board.pieceIndexAt[moverList[rook].location] = -1;
+		moverList[rook].location = (rook == 3) ? from+3 : from-4;
+		moverList[rook].everMoved = undo.pastRookEverMoved;
+		board.board[moverList[rook].location] = 4*mover;
+		board.pieceIndexAt[moverList[rook].location] = rook;
+		board.pieceBB[us][4] ^= rookFromToBB;
+		board.colorBB[us] ^= rookFromToBB;
+	}
+
+	// Restore any piece that was captured (for en passant this is not the square moved to)
+	if (undo.capturedPiece.location)
+	{
+		int captureSquare = undo.capturedPiece.location;
+		opponentList[undo.capturedPiece.index] = undo.capturedPiece;
+		board.board[captureSquare] = undo.capturedPiece.identity * undo.capturedPiece.owner;
+		board.pieceIndexAt[captureSquare] = undo.capturedPiece.index;
+		board.material -= mover*undo.capturedPiece.value;
+		board.pieceBB[!us][undo.capturedPiece.identity] ^= 1ULL << sq120To64[captureSquare];
+		board.colorBB[!us] ^= 1ULL << sq120To64[captureSquare];
+	}
+
+	board.epSq = undo.pastEpSq;
+	board.hashKey = undo.pastHashKey;
+	board.positional = undo.pastPositional;
+
+	// Undo whoever's turn it is
+	board.playersTurn = !board.playersTurn;
+
+	assert(board.hashKey == computeHashKey(board));
+	assert(board.positional == computePositionalScore(board));
+
+	return 1;
+}
+
+bitboard computeHashKey(const boardClass &board)
+{
+	// Computes the Zobrist hash key of a position from scratch. makeMove() and undoMove() keep
+	//	board.hashKey up to date without this; it is used to set the key up and to check it.
+
+	bitboard key = 0;
+
+	for (int i=0; i<16; i++)
+	{
+		if (board.whitePieceList[i].location)
+			key ^= zobristTables.pieceKeys[0][board.whitePieceList[i].identity][sq120To64[board.whitePieceList[i].location]];
+		if (board.blackPieceList[i].location)
+			key ^= zobristTables.pieceKeys[1][board.blackPieceList[i].identity][sq120To64[board.blackPieceList[i].location]];
+	}
+	if (board.playersTurn == 0)
+		key ^= zobristTables.blackToMoveKey;
+	key ^= zobristTables.castlingKeys[board.castlingRights()];
+	if (board.epSq)
+		key ^= zobristTables.epKeys[board.epSq%10 - 1];
+
+	return key;
+}
+
+int lazyEval(const boardClass &board)
+{
+	// This function returns an evaluation of one single board position. 
+	//	Positive numbers favor white, negative numbers favor black.
+	//
+	// There are two parts of the lazy eval:
+	//	1) material advantage
+	//	2) positional advantage
+	//
+	// For (1) we add up the material difference between the sides, for (2) we use square tables
+	//	to give bonuses for pieces on squares that are generally good for them. Both are kept as running
+	//	totals on the board by makeMove() and undoMove(), so all we have to do is read them.
+
+	return board.material + board.positional;
+}
+
+int computePositionalScore(const boardClass &board)
+{
+	// Adds up the square table bonuses of every piece from scratch (see squareTablesClass::pieceSquare).
+	//	board.positional holds the same number, updated move by move; this is used to set it up and to
+	//	check it.
+
+	int score = 0;
+
+	for (int i=0; i<16; i++)
+	{
+		if (board.whitePieceList[i].location) // Make sure the piece is still alive
+			score += squareTables.pieceSquare[0][board.whitePieceList[i].identity][board.whitePieceList[i].location];
+		if (board.blackPieceList[i].location)
+			score += squareTables.pieceSquare[1][board.blackPieceList[i].identity][board.blackPieceList[i].location];
+	}
+
+	return score;
+}
+
+void lazyEvalAllLegalMoves(boardClass &board)
+{
+	// Evaluates all possible moves on the current board for the player to move using a lazy eval. The moves
+	//	and their scores are left in board.legalMoves.
+	//
+	// These scores are from white's point of view, unlike the search's, so they stay out of the
+	//	transposition table; the lazy eval is cheap enough to just redo.
+	int numLegalMoves = generatePseudoLegalMoveList(board, board.legalMoves, board.sideToMove());
+	
+	for (int i=0; i<numLegalMoves; i++)
+	{
+		makeMove(board.legalMoves[i], board);
+		board.legalMoves.scores[i] = lazyEval(board);
+		undoMove(board);
+	}
+}
+
+int negamax(boardClass &board, searchStateStruct &search, int depth, int ply, int alpha, int beta)
+{
+	// Alpha-beta search in negamax form: the score is always from the point of view of the player to move,
+	//	so each side maximizes and a child's score is negated on the way back up. Returns the score of the
+	//	position if it lies between alpha and beta; otherwise just a bound (<= alpha or >= beta).
+	//
+	// Moves are made and undone on the one board, so nothing is copied from node to node. The best line
+	//	found is left in search.pvTable[ply].
+
+	search.pvLength[ply] = 0;
+
+	if (depth <= 0)
+		return quiescence(board, search, ply, alpha, beta);
+
+	if (checkSearchStop(search))
+		return 0;
+
+	if (ply > 0 && isRepetition(board))
+		return 0;
+
+	if (ply >= maxSearchPly-1)
+		return board.playersTurn ? lazyEval(board) : -lazyEval(board);
+
+	// Look the position up in the transposition table. Mate scores are stored relative to this position
+	//	rather than the root, so they are converted on the way in and out.
+	ttHitStruct hit;
+	moveStruct ttMove = {0};
+	if (transpositionTable.probe(board.hashKey, hit))
+	{
+		ttMove = hit.move;
+		if (hit.score >  mateScore - maxSearchPly) hit.score -= ply;
+		if (hit.score < -mateScore + maxSearchPly) hit.score += ply;
+		if (ply > 0 && hit.depth >= depth &&
+			(hit.bound == boundExact || (hit.bound == boundLower && hit.score >= beta) || (hit.bound == boundUpper && hit.score <= alpha)))
+			return hit.score;
+	}
+
+	movePickerClass picker(board, search, ttMove, ply, 0);
+	moveStruct move;
+
+	int originalAlpha = alpha;
+	int bestScore = -infiniteScore;
+	moveStruct bestMove = {0};
+	int numLegalMoves = 0;
+	while (picker.nextMove(move)) // the most promising moves come first
+	{
+		int quiet = !isCaptureOrPromotion(board, move);
+
+		makeMove(move, board);
+		if (inCheck(board, !board.playersTurn)) // the move left our own king in check
+		{
+			undoMove(board);
+			continue;
+		}
+		numLegalMoves++;
+		int score = -negamax(board, search, depth-1, ply+1, -beta, -alpha);
+		undoMove(board);
+
+		if (search.stopped)
+			return 0;
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestMove  = move;
+			if (score > alpha)
+			{
+				alpha = score;
+
+				// Our line is this move followed by the best line of the position it leads to
+				search.pvTable[ply][0] = move;
+				for (int j=0; j<search.pvLength[ply+1]; j++)
+					search.pvTable[ply][j+1] = search.pvTable[ply+1][j];
+				search.pvLength[ply] = search.pvLength[ply+1] + 1;
+
+				if (alpha >= beta) // the opponent won't allow this position, no need to look any further
+				{
+					// Remember quiet moves that cause cutoffs; they'll likely do so in similar positions too
+					if (quiet)
+					{
+						if (search.killers[ply][0].data != move.data)
+						{
+							search.killers[ply][1] = search.killers[ply][0];
+							search.killers[ply][0] = move;
+						}
+						int *history = &search.history[!board.playersTurn][move.data & 0x0FFF];
+						*history += depth*depth;
+						if (*history > historyLimit) // halving keeps the scores from overflowing and lets old cutoffs fade
+						{
+							for (int j=0; j<4096; j++)
+								search.history[!board.playersTurn][j] /= 2;
+						}
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	// No legal moves means checkmate or stalemate
+	if (numLegalMoves == 0)
+		return inCheck(board, board.playersTurn) ? -mateScore + ply : 0;
+
+	int storeScore = bestScore;
+	if (storeScore >  mateScore - maxSearchPly) storeScore += ply;
+	if (storeScore < -mateScore + maxSearchPly) storeScore -= ply;
+	transpositionTable.store(board.hashKey, bestMove, storeScore, depth,
+							 bestScore >= beta ? boundLower : (bestScore > originalAlpha ? boundExact : boundUpper));
+
+	return bestScore;
+}
+
+movePickerClass::movePickerClass(const boardClass &board, const searchStateStruct &search, moveStruct ttMove, int ply, int capturesOnly)
+	: board(board), search(search)
+{
+	this->ttMove = ttMove;
+	this->capturesOnly = capturesOnly;
+	killers[0] = search.killers[ply][0];
+	killers[1] = search.killers[ply][1];
+	if (killers[1].data == killers[0].data)
+		killers[1].data = 0;
+	stage   = stageTTMove;
+	current = 0;
+}
+
+int movePickerClass::nextMove(moveStruct &move)
+{
+	int victimValue, attackerValue;
+
+	while (true)
+	{
+		switch (stage)
+		{
+		case stageTTMove:
+			// The hash move may come from a different position with the same hash key, so check it can be
+			//	played here before handing it out
+			stage = stageGenerateCaptures;
+			if (ttMove.data && (!capturesOnly || isCaptureOrPromotion(board, ttMove)) && isPseudoLegalMove(board, ttMove))
+			{
+				move = ttMove;
+				return 1;
+			}
+			break;
+
+		case stageGenerateCaptures:
+			generateCaptureMoveList(board, moves, board.sideToMove());
+			for (int i=0; i<moves.size(); i++)
+			{
+				captureValues(moves[i], victimValue, attackerValue);
+				moves.scores[i] = 1100*victimValue - attackerValue;
+			}
+			current = 0;
+			stage = stageGoodCaptures;
+			break;
+
+		case stageGoodCaptures:
+			while (current < moves.size())
+			{
+				moves.pickBest(current);
+				move = moves[current++];
+				if (move.data == ttMove.data)
+					continue;
+
+				// Taking a piece worth at least as much as the one taking it can't lose material, so we only
+				//	need the exchange evaluation for the others
+				captureValues(move, victimValue, attackerValue);
+				if (attackerValue > victimValue && staticExchange(board, move) < 0)
+				{
+					badCaptures.add(move);
+					continue;
+				}
+				return 1;
+			}
+			if (capturesOnly)
+			{
+				stage = stageDone;
+				return 0;
+			}
+			current = 0;
+			stage = stageKillers;
+			break;
+
+		case stageKillers:
+			while (current < 2)
+			{
+				move = killers[current++];
+				if (move.data && move.data != ttMove.data && !isCaptureOrPromotion(board, move) && isPseudoLegalMove(board, move))
+					return 1;
+			}
+			stage = stageGenerateQuiets;
+			break;
+
+		case stageGenerateQuiets:
+			generateQuietMoveList(board, moves, board.sideToMove());
+			for (int i=0; i<moves.size(); i++)
+				moves.scores[i] = search.history[!board.playersTurn][moves[i].data & 0x0FFF];
+			current = 0;
+			stage = stageQuiets;
+			break;
+
+		case stageQuiets:
+			while (current < moves.size())
+			{
+				moves.pickBest(current);
+				move = moves[current++];
+				if (move.data != ttMove.data && move.data != killers[0].data && move.data != killers[1].data)
+					return 1;
+			}
+			current = 0;
+			stage = stageBadCaptures;
+			break;
+
+		case stageBadCaptures:
+			if (current < badCaptures.size())
+			{
+				move = badCaptures[current++];
+				return 1;
+			}
+			stage = stageDone;
+			break;
+
+		default:
+			return 0;
+		}
+	}
+}
+
+void movePickerClass::captureValues(moveStruct move, int &victimValue, int &attackerValue) const
+{
+	// The value of what a capture or promotion takes (or gains) and of the piece doing it
+	const pieceClass *moverList    = board.getPieceList(board.sideToMove());
+	const pieceClass *opponentList = board.getPieceList(-board.sideToMove());
+	int to    = getMoveTo(move);
+	int flags = getMoveFlags(move);
+
+	victimValue   = (flags == enPassantCapture) ? pieceValues[1] : (board.board[to] ? opponentList[board.pieceIndexAt[to]].value : 0);
+	attackerValue = moverList[board.pieceIndexAt[getMoveFrom(move)]].value;
+	if (flags & promotion)
+		victimValue += pieceValues[getPromotionIdentity(move)] - pieceValues[1];
+}
+
+int quiescence(boardClass &board, searchStateStruct &search, int ply, int alpha, int beta)
+{
+	// Searches only captures (and promotions) until the position is quiet, so that we never evaluate a
+	//	position half way through an exchange. The player to move doesn't have to capture, so the lazy eval
+	//	of the position ("standing pat") is the least they can get. Captures that the static exchange
+	//	evaluation says lose material are not searched at all.
+	//
+	// When in check, standing pat isn't an option: every move is searched, and no moves means mate.
+
+	search.pvLength[ply] = 0;
+
+	if (checkSearchStop(search))
+		return 0;
+
+	int standPat = board.playersTurn ? lazyEval(board) : -lazyEval(board);
+	if (ply >= maxSearchPly-1)
+		return standPat;
+
+	int check = inCheck(board, board.playersTurn);
+	int bestScore = -infiniteScore;
+	if (!check)
+	{
+		if (standPat >= beta)
+			return standPat;
+		if (standPat > alpha)
+			alpha = standPat;
+		bestScore = standPat;
+	}
+
+	// Out of check we only get the captures that don't lose material
+	moveStruct noMove = {0};
+	movePickerClass picker(board, search, noMove, ply, !check);
+	moveStruct move;
+
+	int numLegalMoves = 0;
+	while (picker.nextMove(move))
+	{
+		if (!check && (getMoveFlags(move) & promotion) && getPromotionIdentity(move) != 5) // only look at queen promotions
+			continue;
+
+		makeMove(move, board);
+		if (inCheck(board, !board.playersTurn)) // the move left our own king in check
+		{
+			undoMove(board);
+			continue;
+		}
+		numLegalMoves++;
+		int score = -quiescence(board, search, ply+1, -beta, -alpha);
+		undoMove(board);
+
+		if (search.stopped)
+			return 0;
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			if (score > alpha)
+			{
+				alpha = score;
+				search.pvTable[ply][0] = move;
+				for (int j=0; j<search.pvLength[ply+1]; j++)
+					search.pvTable[ply][j+1] = search.pvTable[ply+1][j];
+				search.pvLength[ply] = search.pvLength[ply+1] + 1;
+				if (alpha >= beta)
+					break;
+			}
+		}
+	}
+
+	if (check && numLegalMoves == 0)
+		return -mateScore + ply;
+
+	return bestScore;
+}
+
+int checkSearchStop(searchStateStruct &search)
+{
+	// Counts a node and, every so often, checks the clock and whether we've been told to stop. Returns 1
+	//	if the search should stop.
+
+	if ((++search.nodes & 2047) == 0 &&
+		(stopSearch.load(memory_order_relaxed) || (search.limits.seconds > 0 && getTimeInSeconds() > search.stopTime)))
+		search.stopped = 1;
+	return search.stopped;
+}
+
+int isRepetition(const boardClass &board)
+{
+	// Returns 1 if the position has already occurred with the same player to move. A capture can't be
+	//	undone, so we only need to look back as far as the last one.
+
+	for (int i=board.undoCount-1; i>=0; i--)
+	{
+		if ((board.undoCount-i) % 2 == 0 && board.undoStack[i].pastHashKey == board.hashKey)
+			return 1;
+		if (board.undoStack[i].capturedPiece.location)
+			break;
+	}
+	return 0;
+}
+
+void iterativeDeepening(boardClass &board, searchStateStruct &search, searchResultStruct &result)
+{
+	// Iterative deepening: search to depth 1, then 2, and so on until the depth limit or the time runs
+	//	out. Each iteration is quick compared to the next, and the best moves the earlier ones leave in the
+	//	transposition table get searched first by the later ones, which makes them much faster. If the time
+	//	runs out part way through an iteration, the result of the last completed one is used.
+	//
+	// Every search thread runs this on its own copy of the board. Odd numbered helper threads start one
+	//	ply deeper, so the threads aren't all working on the same iteration at the same time.
+
+	double startTime = getTimeInSeconds();
+	result.bestMove.data = 0;
+	result.score    = 0;
+	result.depth    = 0;
+	result.pvLength = 0;
+
+	for (int depth=1+(search.threadNumber & 1); depth<=search.limits.depth && depth<maxSearchPly; depth++)
+	{
+		int score = negamax(board, search, depth, 0, -infiniteScore, infiniteScore);
+		if (search.stopped && result.depth > 0)
+			break;
+
+		result.score    = score;
+		result.depth    = depth;
+		result.pvLength = search.pvLength[0];
+		for (int i=0; i<result.pvLength; i++)
+			result.pv[i] = search.pvTable[0][i];
+		result.bestMove.data = result.pvLength ? result.pv[0].data : 0;
+
+		if (search.threadNumber == 0 && search.limits.output == searchOutputText)
+		{
+			double elapsed = getTimeInSeconds() - startTime;
+			printf("\n\tDepth %2d  score %6d  nodes %10llu  %7.3f s  %10.0f nodes/s  pv", depth, score, search.nodes, elapsed,
+				   elapsed > 0 ? search.nodes/elapsed : 0.0);
+			for (int i=0; i<result.pvLength; i++)
+			{
+				char moveString[6];
+				moveToString(result.pv[i], moveString);
+				printf(" %s", moveString);
+			}
+		}
+		else if (search.threadNumber == 0 && search.limits.output == searchOutputUci)
+		{
+			// Mate scores are given in moves rather than centipawns, negative if we are the ones being mated.
+			//	The line is written in one go, since the UCI loop may be answering the GUI at the same time
+			char line[128 + 6*maxSearchPly];
+			int length;
+			double elapsed = getTimeInSeconds() - startTime;
+			if (score > mateScore - maxSearchPly)
+				length = sprintf(line, "info depth %d score mate %d", depth, (mateScore - score + 1)/2);
+			else if (score < -mateScore + maxSearchPly)
+				length = sprintf(line, "info depth %d score mate %d", depth, -(mateScore + score)/2);
+			else
+				length = sprintf(line, "info depth %d score cp %d", depth, score);
+			length += sprintf(line + length, " nodes %llu nps %.0f time %d pv", search.nodes,
+							  elapsed > 0 ? search.nodes/elapsed : 0.0, (int)(1000*elapsed));
+			for (int i=0; i<result.pvLength; i++)
+			{
+				char moveString[6];
+				moveToString(result.pv[i], moveString);
+				length += sprintf(line + length, " %s", moveString);
+			}
+			strcpy(line + length, "\n");
+			fputs(line, stdout);
+			fflush(stdout);
+		}
+
+		if (search.stopped || result.pvLength == 0 || score > mateScore - maxSearchPly || score < -mateScore + maxSearchPly)
+			break; // no need to look deeper once there are no moves or a mate has been found
+	}
+	result.nodes   = search.nodes;
+	result.seconds = getTimeInSeconds() - startTime;
+
+	// Once the main thread is done, so are the helpers
+	if (search.threadNumber == 0)
+		stopSearch = 1;
+}
+
+void searchPosition(boardClass &board, searchLimitsStruct limits, searchResultStruct &result)
+{
+	// Searches the position with searchThreads threads ("lazy SMP"). Each thread gets its own copy of the
+	//	board, undo stack included, and searches from the same root; they share nothing but the
+	//	transposition table, through which the positions one thread has searched save the others the work.
+	//	The thread that completed the deepest iteration gives the result.
+	//
+	// stopSearch must be 0 when this is called; setting it to 1 from another thread stops the search,
+	//	which then returns the result of the last iteration it completed.
+
+	int numThreads = max(1, searchThreads.load());
+	vector<boardClass>         threadBoards(numThreads-1, board); // thread 0 searches the board itself
+	vector<searchStateStruct>  searchStates(numThreads);
+	vector<searchResultStruct> results(numThreads);
+	vector<thread>             helpers;
+
+	double stopTime = getTimeInSeconds() + limits.seconds;
+	transpositionTable.newSearch();
+
+	for (int t=0; t<numThreads; t++)
+	{
+		searchStates[t].limits       = limits;
+		searchStates[t].stopTime     = stopTime;
+		searchStates[t].nodes        = 0;
+		searchStates[t].threadNumber = t;
+		searchStates[t].stopped      = 0;
+		memset(searchStates[t].killers, 0, sizeof(searchStates[t].killers));
+		memset(searchStates[t].history, 0, sizeof(searchStates[t].history));
+	}
+	for (int t=1; t<numThreads; t++)
+		helpers.push_back(thread(iterativeDeepening, ref(threadBoards[t-1]), ref(searchStates[t]), ref(results[t])));
+	iterativeDeepening(board, searchStates[0], results[0]);
+	for (size_t t=0; t<helpers.size(); t++)
+		helpers[t].join();
+
+	// Pick the result and report how each thread did
+	int best = 0;
+	unsigned long long totalNodes = 0;
+	if (limits.output == searchOutputText)
+		printf("\n");
+	for (int t=0; t<numThreads; t++)
+	{
+		if (results[t].depth > results[best].depth && results[t].bestMove.data)
+			best = t;
+		totalNodes += results[t].nodes;
+		if (limits.output == searchOutputText)
+			printf("\tThread %2d: depth %2d  %10llu nodes  %10.0f nodes/s\n", t, results[t].depth, results[t].nodes,
+				   results[t].seconds > 0 ? results[t].nodes/results[t].seconds : 0.0);
+	}
+	result = results[best];
+	result.nodes = totalNodes;
+	if (limits.output == searchOutputText)
+		printf("\tTotal:              %10llu nodes  %10.0f nodes/s\n", totalNodes, result.seconds > 0 ? totalNodes/result.seconds : 0.0);
+}
+
+void engineThreadClass::start()
+{
+	worker = thread(&engineThreadClass::run, this);
+}
+
+void engineThreadClass::quit()
+{
+	stop();
+	{
+		lock_guard<mutex> guard(commandLock);
+		engineCommandStruct *command = new engineCommandStruct;
+		command->type = engineQuit;
+		commands.push_back(command);
+	}
+	commandReady.notify_one();
+	worker.join();
+}
+
+void engineThreadClass::send(int type, const boardClass &position, searchLimitsStruct limits)
+{
+	// Drops any commands still waiting, stops the current search and queues the new one
+	engineCommandStruct *command = new engineCommandStruct; // boards are too big to copy around on the stack
+	command->type     = type;
+	command->limits   = limits;
+	command->position = position;
+
+	{
+		lock_guard<mutex> guard(commandLock);
+		for (size_t i=0; i<commands.size(); i++)
+			delete commands[i];
+		commands.clear();
+		stopSearch = 1;
+		commands.push_back(command);
+		state       = type == engineSearch || type == enginePonder ? type : engineIdle;
+		positionKey = position.hashKey;
+	}
+	commandReady.notify_one();
+}
+
+void engineThreadClass::stop()
+{
+	lock_guard<mutex> guard(commandLock);
+	for (size_t i=0; i<commands.size(); i++)
+		delete commands[i];
+	commands.clear();
+	stopSearch = 1;
+	state = engineIdle;
+}
+
+int engineThreadClass::takeResult(searchResultStruct &result, bitboard &resultKey)
+{
+	lock_guard<mutex> guard(commandLock);
+	if (!resultReady)
+		return 0;
+	result    = this->result;
+	resultKey = this->resultKey;
+	resultReady = 0;
+	return 1;
+}
+
+void engineThreadClass::run()
+{
+	// The engine thread: wait for a command, carry it out, repeat
+	while (true)
+	{
+		engineCommandStruct *command;
+		{
+			unique_lock<mutex> guard(commandLock);
+			commandReady.wait(guard, [this]{ return !commands.empty(); });
+			command = commands.front();
+			commands.pop_front();
+
+			// Taking the command and clearing the stop flag under the lock means a stop sent from now on
+			//	can't be missed
+			stopSearch = 0;
+		}
+
+		if (command->type == engineQuit)
+		{
+			delete command;
+			return;
+		}
+
+		if (command->type == engineSearch || command->type == enginePonder)
+		{
+			searchResultStruct searchResult;
+			searchPosition(command->position, command->limits, searchResult);
+
+			// Publish the move found; pondering has nothing to publish, it just fills the table
+			lock_guard<mutex> guard(commandLock);
+			if (command->type == engineSearch)
+			{
+				result      = searchResult;
+				resultKey   = command->position.hashKey;
+				resultReady = 1;
+			}
+			if (commands.empty())
+				state = engineIdle;
+		}
+		delete command;
+	}
+}
+
+void displayMoveScores(const boardClass &board)
+{
+	int numMoveScores = board.legalMoves.size();
+	for (int i=0; i<numMoveScores; i++)
+	{
+		printf("\n\t%d->%d: %d", getMoveFrom(board.legalMoves[i]), getMoveTo(board.legalMoves[i]), board.legalMoves.scores[i]);
+	}
+}
+
+int checkMoveLegality(moveStruct &potentialMove, const boardClass &board)
+{
+	// This function is meant to check the legality of a desired move for the player to move. If the move is 
+	//	legal the function returns 1, if the move is not legal the function returns 0
+	//
+	// Only the from and to squares of potentialMove are looked at. If the move is legal, potentialMove is
+	//	replaced by the matching move from the legal move list, so it knows whether it is e.g. a castle or
+	//	an en passant capture. A pawn reaching the last rank promotes to a queen.
+
+	int moveLegal = 0;
+	moveListClass legalMoveList;
+
+	int numLegalMoves = generatePseudoLegalMoveList(board, legalMoveList, board.sideToMove());
+	
+	//int numLegalMoves = generateFullLegalMoveList(board, legalMoveList);
+
+	for (int i=0; i<numLegalMoves; i++)
+	{
+		if ((potentialMove.data & 0x0FFF) == (legalMoveList[i].data & 0x0FFF)) // same from and to squares
+		{
+			if (!moveLegal || getMoveFlags(legalMoveList[i]) == promotion + 3) // prefer the queen promotion
+				potentialMove = legalMoveList[i];
+			moveLegal = 1;
+		}
+	}
+
+	return moveLegal;
+}
+int loadFen(const char *fen, boardClass &board)
+{
+	// This function sets up the board, both piece lists and the player to move from a FEN string, e.g.
+	//	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1". The return value is 1 if the string
+	//	was understood and 0 if not (in which case the position should not be trusted).
+	//
+	// The fen ends at a '\0' or at the end of the line, and anything after the en passant square (the
+	//	clocks, or an EPD line's operations) is ignored, so a line of an EPD file can be loaded straight
+	//	from wherever it is in memory. Nothing is allocated.
+	//
+	// Pieces are put into the piece list slots given by the usual convention (see initializePieceList()).
+	//	Any extra pieces (e.g. a third knight after a promotion) are put into whatever slot is still free,
+	//	in the same way the Swift version stores them in the slots of missing pawns.
+
+	int firstSlot[7]       = {0, 8, 6, 4, 2, 1, 0}; // first preferred slot for each identity
+	int lastSlot[7]        = {0, 15, 7, 5, 3, 1, 0}; // last preferred slot for each identity
+	int loc = 0, slot, identity, owner;
+	pieceClass *whitePieceList = board.whitePieceList;
+	pieceClass *blackPieceList = board.blackPieceList;
+	pieceClass *pieceList;
+	const char *c = fen;
+
+	// Start from an empty board, copied from one set up the first time we get here
+	struct emptyPositionStruct { int board[120]; pieceClass whitePieceList[16], blackPieceList[16]; };
+	static const emptyPositionStruct emptyPosition = []
+	{
+		emptyPositionStruct empty;
+		for (int i=0; i<120; i++)
+			empty.board[i] = (i/10 >= 2 && i/10 <= 9 && i%10 >= 1 && i%10 <= 8) ? 0 : -99;
+		for (int i=0; i<16; i++)
+		{
+			empty.whitePieceList[i].initializePiece(0, 0, 0, 1, 1, i);
+			empty.blackPieceList[i].initializePiece(0, 0, 0, 1, -1, i);
+		}
+		return empty;
+	}();
+	memcpy(board.board, emptyPosition.board, sizeof(board.board));
+	memcpy(whitePieceList, emptyPosition.whitePieceList, sizeof(emptyPosition.whitePieceList));
+	memcpy(blackPieceList, emptyPosition.blackPieceList, sizeof(emptyPosition.blackPieceList));
+	board.material = 0;
+	board.undoCount = 0;
+	board.epSq = 0;
+
+	// Piece placement, starting from a8 and working towards h1. Every rank has to fill exactly 8 squares.
+	int rankEnd = 8;
+	while (*c && *c != ' ' && *c != '\n' && *c != '\r')
+	{
+		if (*c == '/')
+		{
+			if (loc != rankEnd || rankEnd == 64)
+				return 0;
+			rankEnd += 8;
+		}
+		else if (*c >= '1' && *c <= '8')
+		{
+			loc += *c - '0';
+			if (loc > rankEnd)
+				return 0;
+		}
+		else
+		{
+			if (loc >= rankEnd)
+				return 0;
+			switch (*c | 32) // lower case
+			{
+				case 'p': identity = 1; break;
+				case 'n': identity = 2; break;
+				case 'b': identity = 3; break;
+				case 'r': identity = 4; break;
+				case 'q': identity = 5; break;
+				case 'k': identity = 6; break;
+				default:  return 0;
+			}
+			owner = (*c >= 'a') ? -1 : 1;
+			pieceList = board.getPieceList(owner);
+
+			// Find a slot for this piece
+			for (slot=firstSlot[identity]; slot<=lastSlot[identity] && pieceList[slot].location; slot++);
+			if (slot > lastSlot[identity])
+				for (slot=15; slot>=0 && pieceList[slot].location; slot--);
+			if (slot < 0 || (identity == 6 && slot != 0))
+				return 0;
+
+			int sq = 10*(loc/8 + 2) + (loc%8 + 1);
+			pieceList[slot].initializePiece(identity, pieceValues[identity], sq, 1, owner, slot);
+			board.board[sq] = identity*owner;
+			board.material += pieceValues[identity]*owner;
+
+			// Pawns that are still on their starting rank have never moved
+			if (identity == 1 && ((owner == 1 && sq/10 == 8) || (owner == -1 && sq/10 == 3)))
+				pieceList[slot].everMoved = 0;
+
+			loc++;
+		}
+		c++;
+	}
+	if (loc != 64 || rankEnd != 64 || !whitePieceList[0].location || !blackPieceList[0].location)
+		return 0; // a second king is already turned away above, as it can't go in slot 0
+
+	// Side to move
+	while (*c == ' ') c++;
+	if (*c == 'w')
+		board.playersTurn = 1;
+	else if (*c == 'b')
+		board.playersTurn = 0;
+	else
+		return 0;
+	c++;
+
+	// Castling rights
+	//	We keep castling rights the same way the rest of the program does: the king and the castling rook
+	//	have never moved, and the rook is stored in slot 2 (a-file) or slot 3 (h-file).
+	while (*c == ' ') c++;
+	for (; *c && *c != ' ' && *c != '\n' && *c != '\r'; c++)
+	{
+		if (*c == '-')
+			continue;
+		if (!strchr("KQkq", *c))
+			return 0;
+
+		owner     = (*c >= 'a') ? -1 : 1;
+		pieceList = board.getPieceList(owner);
+		int rookSq  = ((*c | 32) == 'k') ? pieceList[0].location + 3 : pieceList[0].location - 4;
+		int rookSlot = ((*c | 32) == 'k') ? 3 : 2;
+
+		for (slot=0; slot<16 && !(pieceList[slot].location == rookSq && pieceList[slot].identity == 4); slot++);
+		if (slot == 16)
+			continue; // no rook where the castling rights say there should be one
+
+		// Swap the castling rook into its conventional slot
+		pieceClass tempPiece     = pieceList[rookSlot];
+		pieceList[rookSlot]      = pieceList[slot];
+		pieceList[slot]          = tempPiece;
+		pieceList[rookSlot].index = rookSlot;
+		pieceList[slot].index     = slot;
+
+		pieceList[rookSlot].everMoved = 0;
+		pieceList[0].everMoved = 0;
+	}
+
+	// En passant square; we store the location of the pawn that can be captured. The square is only taken
+	//	when it could have come from a double push (on the third or sixth rank, an enemy pawn in front of it
+	//	and both squares it passed over empty), the same positions makeMove() leaves an en passant square in.
+	//	Anything else is ignored, so it can't be captured or hashed.
+	while (*c == ' ') c++;
+	if (*c >= 'a' && *c <= 'h' && c[1] >= '1' && c[1] <= '8')
+	{
+		int player = board.sideToMove();
+		int target = 10*(8 - (c[1]-'0') + 2) + (c[0]-'a' + 1);
+		int pawnSq = target + 10*player;
+		if (c[1] == (player == 1 ? '6' : '3') && board.board[pawnSq] == -player &&
+			board.board[target] == 0 && board.board[target - 10*player] == 0)
+			board.epSq = pawnSq;
+	}
+
+	// The halfmove clock and the fullmove number are not used
+	board.syncFromPieceLists();
+
+	// The side that just moved can't be left in check; searching such a position would capture a king
+	if (inCheck(board, !board.playersTurn))
+		return 0;
+	return 1;
+}
+
+int writeFen(const boardClass &board, char fen[maxFenLength])
+{
+	// Writes the position as a FEN string and returns its length. We don't keep a halfmove clock or know
+	//	what move number the position was set up at, so the halfmove clock is written as 0 and the moves
+	//	are counted from move 1 at setup. Nothing is allocated.
+	char *c = fen;
+	int rank, file;
+
+	// Piece placement, from a8 to h1
+	for (rank=2; rank<=9; rank++)
+	{
+		int empty = 0;
+		for (file=1; file<=8; file++)
+		{
+			int piece = board.board[10*rank + file];
+			if (piece == 0)
+			{
+				empty++;
+				continue;
+			}
+			if (empty)
+				*c++ = '0' + empty;
+			empty = 0;
+			*c++ = piece > 0 ? " PNBRQK"[piece] : " pnbrqk"[-piece];
+		}
+		if (empty)
+			*c++ = '0' + empty;
+		if (rank < 9)
+			*c++ = '/';
+	}
+
+	// Side to move and castling rights
+	*c++ = ' ';
+	*c++ = board.playersTurn ? 'w' : 'b';
+	*c++ = ' ';
+	int rights = board.castlingRights();
+	if (rights & 1) *c++ = 'K';
+	if (rights & 2) *c++ = 'Q';
+	if (rights & 4) *c++ = 'k';
+	if (rights & 8) *c++ = 'q';
+	if (!rights)    *c++ = '-';
+
+	// En passant square, the square behind the pawn that can be captured
+	*c++ = ' ';
+	if (board.epSq)
+	{
+		int target = board.epSq + (board.playersTurn ? -10 : 10);
+		*c++ = 'a' + target%10 - 1;
+		*c++ = '8' - (target/10 - 2);
+	}
+	else
+		*c++ = '-';
+
+	int startedWithBlack = (board.undoCount & 1) ? board.playersTurn : !board.playersTurn;
+	c += sprintf(c, " 0 %d", 1 + (board.undoCount + startedWithBlack)/2);
+	return (int)(c - fen);
+}
+
+void moveToString(moveStruct move, char moveString[6])
+{
+	// Writes a move in coordinate notation, e.g. "e2e4", or "e7e8q" for a promotion
+	moveString[0] = 'a' + getMoveFrom(move)%10 - 1;
+	moveString[1] = '8' - (getMoveFrom(move)/10 - 2);
+	moveString[2] = 'a' + getMoveTo(move)%10 - 1;
+	moveString[3] = '8' - (getMoveTo(move)/10 - 2);
+	moveString[4] = '\0';
+	if (getMoveFlags(move) & promotion)
+	{
+		moveString[4] = " pnbrqk"[getPromotionIdentity(move)];
+		moveString[5] = '\0';
+	}
+}
+
+int parseMove(boardClass &board, const char *moveString, moveStruct &move)
+{
+	// Finds the legal move written in coordinate notation (as moveToString() writes it) in the position
+	//	on the board. Returns 1 if there is one, 0 if the string isn't a legal move.
+	moveListClass legalMoveList;
+	generateFullLegalMoveList(board, legalMoveList);
+	for (int i=0; i<legalMoveList.size(); i++)
+	{
+		char legalString[6];
+		moveToString(legalMoveList[i], legalString);
+		if (strcmp(legalString, moveString) == 0)
+		{
+			move = legalMoveList[i];
+			return 1;
+		}
+	}
+	return 0;
+}
+
+double getTimeInSeconds()
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned long long perft(boardClass &board, int depth)
+{
+	// Counts the leaf nodes of the legal move tree of the given depth. The board and piece lists are
+	//	returned unchanged.
+
+	if (depth == 0)
+		return 1;
+
+	moveListClass legalMoveList;
+	int numLegalMoves = generateFullLegalMoveList(board, legalMoveList);
+
+	if (depth == 1)
+		return numLegalMoves;
+
+	unsigned long long nodes = 0;
+	for (int i=0; i<numLegalMoves; i++)
+	{
+		makeMove(legalMoveList[i], board);
+		nodes += perft(board, depth-1);
+		undoMove(board);
+	}
+
+	return nodes;
+}
+
+void perftDivide(boardClass &board, int depth)
+{
+	// Same as perft(), but prints the number of leaf nodes below each root move. Comparing these numbers
+	//	against another engine is the quickest way to find the subtree a movegen bug lives in.
+
+	moveListClass legalMoveList;
+	char moveString[6];
+	unsigned long long nodes, total = 0;
+
+	double startTime = getTimeInSeconds();
+	int numLegalMoves = generateFullLegalMoveList(board, legalMoveList);
+
+	for (int i=0; i<numLegalMoves; i++)
+	{
+		makeMove(legalMoveList[i], board);
+		nodes = perft(board, depth-1);
+		undoMove(board);
+
+		moveToString(legalMoveList[i], moveString);
+		printf("\t%s: %llu\n", moveString, nodes);
+		total += nodes;
+	}
+	double elapsed = getTimeInSeconds() - startTime;
+
+	printf("\n\tMoves: %d\n", numLegalMoves);
+	printf("\tNodes: %llu\n", total);
+	printf("\tTime:  %.3f s (%.0f nodes/s)\n", elapsed, elapsed > 0 ? total/elapsed : 0.0);
+}
+
+bitboard bishopAttacks(int square, bitboard occupied)
+{
+	// Squares attacked by a bishop on the given square (0-63)
+#ifdef __BMI2__
+	return bitboardTables.bishopTable[bitboardTables.bishopTableStart[square] + _pext_u64(occupied, bitboardTables.bishopMask[square])];
+#else
+	return bitboardTables.bishopTable[bitboardTables.bishopTableStart[square] + 
+		(((occupied & bitboardTables.bishopMask[square]) * bitboardTables.bishopMagic[square]) >> bitboardTables.bishopShift[square])];
+#endif
+}
+
+bitboard rookAttacks(int square, bitboard occupied)
+{
+	// Squares attacked by a rook on the given square (0-63)
+#ifdef __BMI2__
+	return bitboardTables.rookTable[bitboardTables.rookTableStart[square] + _pext_u64(occupied, bitboardTables.rookMask[square])];
+#else
+	return bitboardTables.rookTable[bitboardTables.rookTableStart[square] + 
+		(((occupied & bitboardTables.rookMask[square]) * bitboardTables.rookMagic[square]) >> bitboardTables.rookShift[square])];
+#endif
+}
+
+int generateMoveListBitboard(const boardClass &board, moveListClass &moveList, int player, bitboard targetMask,
+							 int withPromotions, int withCastling)
+{
+	// Bitboard version of generatePseudoLegalMoveListMailbox(). Rather than walking each piece's moves
+	//	square by square we look up the set of squares it can reach and pull the moves out of that set
+	//	one bit at a time.
+	//
+	// Only moves to squares in targetMask are generated: everything not our own for all the moves, the
+	//	enemy pieces for the captures and the empty squares for the quiet moves. Pawn pushes that promote
+	//	and castling don't fit that, so withPromotions and withCastling say whether to add them. En passant
+	//	goes with the captures, i.e. it's added when targetMask has enemy pieces in it.
+
+	int us = (player == 1) ? 0 : 1;
+	bitboard own      = board.colorBB[us];
+	bitboard enemy    = board.colorBB[!us];
+	bitboard occupied = own | enemy;
+	bitboard empty    = ~occupied;
+	bitboard pieces, targets, singlePushes, doublePushes, promotions, lastRank;
+	int from, to;
+
+	moveList.clear();
+
+	// Pawns
+	pieces = board.pieceBB[us][1];
+	int pushOffset;
+	if (player == 1)
+	{
+		singlePushes = (pieces << 8) & empty;
+		doublePushes = ((singlePushes & 0x0000000000FF0000ULL) << 8) & empty; // pushed from the 2nd rank to the 3rd
+		lastRank = 0xFF00000000000000ULL;
+		pushOffset = 8;
+	}
+	else
+	{
+		singlePushes = (pieces >> 8) & empty;
+		doublePushes = ((singlePushes & 0x0000FF0000000000ULL) >> 8) & empty; // pushed from the 7th rank to the 6th
+		lastRank = 0x00000000000000FFULL;
+		pushOffset = -8;
+	}
+	promotions    = withPromotions ? (singlePushes & lastRank) : 0;
+	singlePushes &= ~lastRank & targetMask;
+	doublePushes &= targetMask;
+	while (singlePushes)
+	{
+		to = popLowestBit(singlePushes);
+		moveList.add(makeMoveStruct(sq64To120[to - pushOffset], sq64To120[to]));
+	}
+	while (promotions)
+	{
+		to = popLowestBit(promotions);
+		addPawnMove(moveList, sq64To120[to - pushOffset], sq64To120[to]);
+	}
+	while (doublePushes)
+	{
+		to = popLowestBit(doublePushes);
+		moveList.add(makeMoveStruct(sq64To120[to - 2*pushOffset], sq64To120[to], doublePawnPush));
+	}
+	if (board.epSq != 0 && (targetMask & enemy))
+	{
+		// En passant: our pawns attacking the square behind the pawn that just moved two squares
+		//	are exactly the pawns an enemy pawn on that square would attack
+		to = sq120To64[board.epSq - 10*player];
+		targets = bitboardTables.pawnAttacks[!us][to] & pieces;
+		while (targets)
+			moveList.add(makeMoveStruct(sq64To120[popLowestBit(targets)], sq64To120[to], enPassantCapture));
+	}
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = bitboardTables.pawnAttacks[us][from] & enemy & targetMask;
+		while (targets)
+			addPawnMove(moveList, sq64To120[from], sq64To120[popLowestBit(targets)]);
+	}
+
+	// Knights
+	pieces = board.pieceBB[us][2];
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = bitboardTables.knightAttacks[from] & targetMask;
+		while (targets)
+			moveList.add(makeMoveStruct(sq64To120[from], sq64To120[popLowestBit(targets)]));
+	}
+
+	// Bishops and queens along the diagonals
+	pieces = board.pieceBB[us][3] | board.pieceBB[us][5];
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = bishopAttacks(from, occupied) & targetMask;
+		while (targets)
+			moveList.add(makeMoveStruct(sq64To120[from], sq64To120[popLowestBit(targets)]));
+	}
+
+	// Rooks and queens along the files and ranks
+	pieces = board.pieceBB[us][4] | board.pieceBB[us][5];
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = rookAttacks(from, occupied) & targetMask;
+		while (targets)
+			moveList.add(makeMoveStruct(sq64To120[from], sq64To120[popLowestBit(targets)]));
+	}
+
+	// King
+	pieces = board.pieceBB[us][6];
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = bitboardTables.kingAttacks[from] & targetMask;
+		while (targets)
+			moveList.add(makeMoveStruct(sq64To120[from], sq64To120[popLowestBit(targets)]));
+	}
+
+	// Castling
+	if (withCastling)
+		addCastlingMoves(board, moveList, player);
+
+	return moveList.size();
+}
+
+int isSquareAttackedBitboard(const boardClass &board, int square, int byPlayer)
+{
+	// Bitboard version of isSquareAttacked(). As with the mailbox version we look outward from the square:
+	//	e.g. a knight on the square would attack exactly the squares an enemy knight could attack it from.
+
+	int sq = sq120To64[square];
+	int by = (byPlayer == 1) ? 0 : 1;
+	bitboard occupied = board.colorBB[0] | board.colorBB[1];
+
+	if (bitboardTables.pawnAttacks[!by][sq] & board.pieceBB[by][1])
+		return 1;
+	if (bitboardTables.knightAttacks[sq] & board.pieceBB[by][2])
+		return 1;
+	if (bitboardTables.kingAttacks[sq] & board.pieceBB[by][6])
+		return 1;
+	if (bishopAttacks(sq, occupied) & (board.pieceBB[by][3] | board.pieceBB[by][5]))
+		return 1;
+	if (rookAttacks(sq, occupied) & (board.pieceBB[by][4] | board.pieceBB[by][5]))
+		return 1;
+
+	return 0;
+}
+
+bitboard attackersTo(const boardClass &board, int square, bitboard occupied)
+{
+	// All pieces of either color attacking the given square (0-63), with sliding pieces seeing through
+	//	everything not in occupied. Pieces not in occupied are still included; callers mask them out.
+
+	return (bitboardTables.pawnAttacks[1][square] & board.pieceBB[0][1]) |
+		   (bitboardTables.pawnAttacks[0][square] & board.pieceBB[1][1]) |
+		   (bitboardTables.knightAttacks[square] & (board.pieceBB[0][2] | board.pieceBB[1][2])) |
+		   (bitboardTables.kingAttacks[square]   & (board.pieceBB[0][6] | board.pieceBB[1][6])) |
+		   (bishopAttacks(square, occupied) & (board.pieceBB[0][3] | board.pieceBB[1][3] | board.pieceBB[0][5] | board.pieceBB[1][5])) |
+		   (rookAttacks(square, occupied)   & (board.pieceBB[0][4] | board.pieceBB[1][4] | board.pieceBB[0][5] | board.pieceBB[1][5]));
+}
+
+int staticExchange(const boardClass &board, moveStruct move)
+{
+	// Static exchange evaluation: works out what a capture wins or loses once all the captures back and
+	//	forth on its square are played out, each side always capturing with its least valuable piece and
+	//	free to stop whenever carrying on would lose. Returns the material gained by the player making the
+	//	move (negative if it loses material). Pieces behind others on the same line join in as the pieces in
+	//	front of them are used up.
+
+	static const int exchangeValues[7] = {0, 100, 325, 335, 540, 1050, 20000}; // the king can't be given up
+	int gain[32];
+	int from  = sq120To64[getMoveFrom(move)];
+	int to    = sq120To64[getMoveTo(move)];
+	int flags = getMoveFlags(move);
+	int side  = !board.playersTurn; // 0=white, 1=black
+
+	bitboard occupied = board.colorBB[0] | board.colorBB[1];
+	int attacker = board.board[getMoveFrom(move)] * (side ? -1 : 1); // identity of the piece moving
+	int depth = 0;
+
+	gain[0] = exchangeValues[abs(board.board[getMoveTo(move)])];
+	if (flags == enPassantCapture)
+	{
+		gain[0] = exchangeValues[1];
+		occupied ^= 1ULL << sq120To64[getMoveTo(move) + 10*board.sideToMove()];
+	}
+	if (flags & promotion)
+	{
+		attacker = getPromotionIdentity(move);
+		gain[0] += exchangeValues[attacker] - exchangeValues[1];
+	}
+
+	bitboard fromBB = 1ULL << from;
+	bitboard attackers = attackersTo(board, to, occupied);
+	do
+	{
+		// The piece that just captured may now be taken in turn
+		depth++;
+		gain[depth] = exchangeValues[attacker] - gain[depth-1];
+		if (max(-gain[depth-1], gain[depth]) < 0) // neither side can come out ahead by carrying on
+			break;
+
+		occupied  ^= fromBB;
+		attackers |= attackersTo(board, to, occupied); // pieces that were hidden behind it
+		attackers &= occupied;
+		side = !side;
+
+		// The other side's least valuable attacker
+		fromBB = 0;
+		for (attacker=1; attacker<=6; attacker++)
+		{
+			bitboard candidates = attackers & board.pieceBB[side][attacker];
+			if (candidates)
+			{
+				fromBB = candidates & (0 - candidates);
+				break;
+			}
+		}
+	} while (fromBB && depth < 31);
+
+	// Each side can either capture or stop, whichever is better for it, working back from the end
+	while (--depth)
+		gain[depth-1] = -max(-gain[depth-1], gain[depth]);
+
+	return gain[0];
+}
+
+int generateLegalMoveListBitboard(const boardClass &board, moveListClass &legalMoveList)
+{
+	// Generates only legal moves for the player to move, without making any of them. Before generating
+	//	anything we work out, once for the position:
+	//	- the checkers: enemy pieces attacking our king. In double check only the king can move; in single
+	//	  check every other piece must capture the checker or block its line to the king.
+	//	- the pinned pieces: our pieces that are the only thing between our king and an enemy slider. A
+	//	  pinned piece may only move along the line between the two.
+	//	The king itself may not step onto an attacked square, and we look for attackers with the king
+	//	taken off the board so it can't hide behind itself from a slider.
+
+	int player = board.sideToMove();
+	int us     = board.playersTurn ? 0 : 1;
+	bitboard own      = board.colorBB[us];
+	bitboard enemy    = board.colorBB[!us];
+	bitboard occupied = own | enemy;
+	bitboard pieces, targets;
+	int from, to;
+
+	legalMoveList.clear();
+
+	int kingSquare = bitScanForward(board.pieceBB[us][6]);
+	bitboard checkers = attackersTo(board, kingSquare, occupied) & enemy;
+
+	// King moves
+	targets = bitboardTables.kingAttacks[kingSquare] & ~own;
+	while (targets)
+	{
+		to = popLowestBit(targets);
+		if (!(attackersTo(board, to, occupied ^ (1ULL << kingSquare)) & enemy & ~(1ULL << to)))
+			legalMoveList.add(makeMoveStruct(sq64To120[kingSquare], sq64To120[to]));
+	}
+	if (checkers & (checkers - 1)) // double check
+		return legalMoveList.size();
+
+	// Where the other pieces may go
+	bitboard allowed = ~own;
+	if (checkers)
+		allowed = checkers | bitboardTables.between[kingSquare][bitScanForward(checkers)];
+
+	// Pinned pieces, and the line each of them must stay on
+	bitboard pinned = 0;
+	bitboard pinLine[64];
+	bitboard snipers = (bishopAttacks(kingSquare, 0) & (board.pieceBB[!us][3] | board.pieceBB[!us][5])) |
+					   (rookAttacks(kingSquare, 0)   & (board.pieceBB[!us][4] | board.pieceBB[!us][5]));
+	while (snipers)
+	{
+		int sniper = popLowestBit(snipers);
+		bitboard blockers = bitboardTables.between[kingSquare][sniper] & occupied;
+		if (blockers && !(blockers & (blockers - 1)) && (blockers & own))
+		{
+			pinned |= blockers;
+			pinLine[bitScanForward(blockers)] = bitboardTables.between[kingSquare][sniper] | (1ULL << sniper);
+		}
+	}
+
+	// Pawns
+	pieces = board.pieceBB[us][1];
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		bitboard pawnAllowed = allowed;
+		if (pinned & (1ULL << from))
+			pawnAllowed &= pinLine[from];
+
+		to = from + 8*player;
+		if (!(occupied & (1ULL << to)))
+		{
+			if (pawnAllowed & (1ULL << to))
+				addPawnMove(legalMoveList, sq64To120[from], sq64To120[to]);
+			if ((player == 1 ? from/8 == 1 : from/8 == 6) && !(occupied & (1ULL << (to + 8*player))) &&
+				(pawnAllowed & (1ULL << (to + 8*player))))
+				legalMoveList.add(makeMoveStruct(sq64To120[from], sq64To120[to + 8*player], doublePawnPush));
+		}
+		targets = bitboardTables.pawnAttacks[us][from] & enemy & pawnAllowed;
+		while (targets)
+			addPawnMove(legalMoveList, sq64To120[from], sq64To120[popLowestBit(targets)]);
+	}
+
+	// En passant is rare and odd (two pawns leave the king's lines at once), so we simply check whether
+	//	anything but the captured pawn attacks the king once the capture is made
+	if (board.epSq != 0)
+	{
+		to = sq120To64[board.epSq - 10*player];
+		bitboard capturedBB = 1ULL << sq120To64[board.epSq];
+		pieces = bitboardTables.pawnAttacks[!us][to] & board.pieceBB[us][1];
+		while (pieces)
+		{
+			from = popLowestBit(pieces);
+			bitboard occupiedAfter = (occupied ^ (1ULL << from) ^ capturedBB) | (1ULL << to);
+			if (!(attackersTo(board, kingSquare, occupiedAfter) & enemy & ~capturedBB & occupiedAfter))
+				legalMoveList.add(makeMoveStruct(sq64To120[from], sq64To120[to], enPassantCapture));
+		}
+	}
+
+	// Knights (a pinned knight can never move)
+	pieces = board.pieceBB[us][2] & ~pinned;
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = bitboardTables.knightAttacks[from] & allowed & ~own;
+		while (targets)
+			legalMoveList.add(makeMoveStruct(sq64To120[from], sq64To120[popLowestBit(targets)]));
+	}
+
+	// Bishops, rooks and queens
+	pieces = board.pieceBB[us][3] | board.pieceBB[us][4] | board.pieceBB[us][5];
+	while (pieces)
+	{
+		from = popLowestBit(pieces);
+		targets = 0;
+		if (board.pieceBB[us][3] & (1ULL << from) || board.pieceBB[us][5] & (1ULL << from))
+			targets |= bishopAttacks(from, occupied);
+		if (board.pieceBB[us][4] & (1ULL << from) || board.pieceBB[us][5] & (1ULL << from))
+			targets |= rookAttacks(from, occupied);
+		targets &= allowed & ~own;
+		if (pinned & (1ULL << from))
+			targets &= pinLine[from];
+		while (targets)
+			legalMoveList.add(makeMoveStruct(sq64To120[from], sq64To120[popLowestBit(targets)]));
+	}
+
+	// Castling; addCastlingMoves() already makes sure we aren't in check and don't pass through an attacked
+	//	square, which leaves the square the king lands on
+	if (!checkers)
+	{
+		int first = legalMoveList.size();
+		addCastlingMoves(board, legalMoveList, player);
+		for (int i=legalMoveList.size()-1; i>=first; i--)
+			if (isSquareAttacked(board, getMoveTo(legalMoveList[i]), -player))
+				legalMoveList.remove(i);
+	}
+
+	return legalMoveList.size();
+}
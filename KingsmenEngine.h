@@ -0,0 +1,766 @@
+/* ***********************KINGSMEN CHESS ENGINE***************************** */
+/* The engine behind Kingsmen Chess and its ai, Adrastos: the board, move        */
+/* generation, evaluation and search.                                            */
+/*                                                                               */
+/* Nothing in here touches OpenCV or any display. The engine is built into a     */
+/* static library (see CMakeLists.txt) that the OpenCV window (KingsmenChess.cpp) */
+/* and the headless command line tool (KingsmenCli.cpp) are both clients of.     */
+/* ***************************************************************************** */
+
+#ifndef KINGSMEN_ENGINE_H
+#define KINGSMEN_ENGINE_H
+
+// includes
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#ifdef OS_WINDOWS
+	#include <intrin.h>
+#endif
+#ifdef __BMI2__
+	#include <immintrin.h> // _pext_u64
+#endif
+
+
+// bitboards
+//	A bitboard has one bit per square: a1 = bit 0, h1 = bit 7, a8 = bit 56, h8 = bit 63.
+typedef unsigned long long bitboard;
+
+inline int popCount(bitboard bb) // number of set bits
+{
+#ifdef OS_WINDOWS
+	return (int)__popcnt64(bb);
+#else
+	return __builtin_popcountll(bb);
+#endif
+}
+inline int bitScanForward(bitboard bb) // index of the lowest set bit; bb must not be empty
+{
+#ifdef OS_WINDOWS
+	unsigned long index;
+	_BitScanForward64(&index, bb);
+	return (int)index;
+#else
+	return __builtin_ctzll(bb);
+#endif
+}
+inline int bitScanReverse(bitboard bb) // index of the highest set bit; bb must not be empty
+{
+#ifdef OS_WINDOWS
+	unsigned long index;
+	_BitScanReverse64(&index, bb);
+	return (int)index;
+#else
+	return 63 - __builtin_clzll(bb);
+#endif
+}
+inline int popLowestBit(bitboard &bb) // removes the lowest set bit and returns its index
+{
+	int sq = bitScanForward(bb);
+	bb &= bb - 1;
+	return sq;
+}
+
+// Conversion between the 120 square board and the 64 square bitboard indices (-1 = off the board)
+const int sq120To64[120] = 
+	{-1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	 -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	 -1, 56, 57, 58, 59, 60, 61, 62, 63, -1,
+	 -1, 48, 49, 50, 51, 52, 53, 54, 55, -1,
+	 -1, 40, 41, 42, 43, 44, 45, 46, 47, -1,
+	 -1, 32, 33, 34, 35, 36, 37, 38, 39, -1,
+	 -1, 24, 25, 26, 27, 28, 29, 30, 31, -1,
+	 -1, 16, 17, 18, 19, 20, 21, 22, 23, -1,
+	 -1,  8,  9, 10, 11, 12, 13, 14, 15, -1,
+	 -1,  0,  1,  2,  3,  4,  5,  6,  7, -1,
+	 -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	 -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+const int sq64To120[64] = 
+	{91, 92, 93, 94, 95, 96, 97, 98,
+	 81, 82, 83, 84, 85, 86, 87, 88,
+	 71, 72, 73, 74, 75, 76, 77, 78,
+	 61, 62, 63, 64, 65, 66, 67, 68,
+	 51, 52, 53, 54, 55, 56, 57, 58,
+	 41, 42, 43, 44, 45, 46, 47, 48,
+	 31, 32, 33, 34, 35, 36, 37, 38,
+	 21, 22, 23, 24, 25, 26, 27, 28 };
+
+// fen
+const int maxFenLength = 100; // the longest fen writeFen() can write, terminating '\0' included
+
+// moves
+//	A move is packed into 16 bits: bits 0-5 hold the from square and bits 6-11 the to square (as 0-63
+//	bitboard indices), and bits 12-15 say what kind of move it is.
+struct moveStruct		 { unsigned short data; };
+const int normalMove        = 0;  // any move or capture not listed below
+const int doublePawnPush    = 1;
+const int kingsideCastle    = 2;
+const int queensideCastle   = 3;
+const int enPassantCapture  = 4;
+const int promotion         = 8;  // promotions are 8 + (identity of the new piece - 2), i.e. 8=knight ... 11=queen
+
+inline moveStruct makeMoveStruct( int moveFrom, int moveTo, int flags = normalMove ) // squares on the 120 square board
+{
+	moveStruct tempStruct = {(unsigned short)(sq120To64[moveFrom] | (sq120To64[moveTo] << 6) | (flags << 12))};
+	return tempStruct;
+}
+inline int getMoveFrom (moveStruct move) { return sq64To120[move.data & 63]; }        // 120 square board
+inline int getMoveTo   (moveStruct move) { return sq64To120[(move.data >> 6) & 63]; } // 120 square board
+inline int getMoveFlags(moveStruct move) { return move.data >> 12; }
+inline int getPromotionIdentity(moveStruct move) { return (move.data >> 12) - promotion + 2; } // only for promotions
+
+// classes
+class pieceClass
+{
+	// This class contains information about an individual piece.
+	
+	// Later, we will make a list of all pieces for each player.
+	//  To keep track of which pieces are which pieces the following convention is to be used:      
+    /*   entry[i] = 
+                 0 - king          8 - a pawn
+                 1 - queen         9 - b pawn
+                 2 - a rook        10 - c pawn
+                 3 - h rook        11 - d pawn
+                 4 - c bishop      12 - e pawn
+                 5 - f bishop      13 - f pawn 
+                 6 - b knight      14 - g pawn
+                 7 - g knight      15 - h pawn
+                          
+    */
+
+
+public: 
+	int identity;  // 1=pawn, 2=knight, 3=bishop, 4=rook, 5=queen, 6=king
+    int value;     /* 100=pawn, 325=knight, 335=bishop, 540=rook, 1050=queen, 0=king */
+    int location;  /* where the piece is on the board, given on a 120-byte board representation
+                        a1 = 91, h1 = 98, a8 = 21 & h8 = 28, notice this leaves two rows above/below 
+                        and one column to either side of the board. This will be useful for edge detection */
+    int everMoved; /* has this piece ever moved before, 0=no, 1=yes */ 
+	int owner;     // 1=white, -1=black
+	int index;     // pieces are numbered 0 to 15 per side; this enables unique identification between identical pieces
+       
+    /*...*/              /* other things to be added later */
+
+	pieceClass()
+	{
+		identity = 0;
+		value = 0;
+		location = 0;
+		everMoved = 0;
+		owner = 0;
+		index = -1;
+	};
+
+	void initializePiece(int a, int b, int c, int d, int e, int f)
+	{
+		identity = a;
+		value = b;
+		location = c;
+		everMoved = d;
+		owner = e;
+		index = f;
+	}
+
+};
+struct undoStruct
+{
+	// Everything makeMove() changes that undoMove() can't work out from the move itself
+	moveStruct move;            // the move that was made
+	pieceClass capturedPiece;   // the piece this move captured; location==0 if nothing was captured
+	int        pastEverMovedStatus; // the everMoved status of the moving piece before the move
+	int        castlingRook;    // piece list index of the rook moved when castling (2 or 3), -1 if not castling
+	int        pastRookEverMoved; // the everMoved status of that rook before castling
+	int        pastEpSq;        // the en passant square before the move
+	bitboard   pastHashKey;     // the hash key before the move
+	int        pastPositional;  // the positional score before the move
+};
+class moveListClass
+{
+	// A list of moves with room for a score next to each one. The storage is a fixed array, so building
+	//	a list never allocates; 256 is more than the number of moves possible in any chess position.
+
+public:
+	static const int maxMoves = 256;
+	moveStruct moves[maxMoves];
+	int        scores[maxMoves]; // e.g. evaluations or move ordering scores; filled in by whoever needs them
+	int        count;
+
+	moveListClass() { count = 0; }
+
+	void clear() { count = 0; }
+	int  size() const { return count; }
+	void add(moveStruct move) { moves[count++] = move; }
+
+	// Removes a move by moving the last move into its place, so the order of the list is not kept
+	void remove(int i)
+	{
+		count--;
+		moves[i]  = moves[count];
+		scores[i] = scores[count];
+	}
+
+	// Moves the highest scoring of the moves from first on into position first. Calling this for each
+	//	move in turn sorts the list, but a search that gets a cutoff early never pays for sorting the rest.
+	void pickBest(int first)
+	{
+		int best = first;
+		for (int i=first+1; i<count; i++)
+			if (scores[i] > scores[best])
+				best = i;
+		if (best != first)
+		{
+			moveStruct tempMove = moves[first]; moves[first] = moves[best]; moves[best] = tempMove;
+			int tempScore = scores[first]; scores[first] = scores[best]; scores[best] = tempScore;
+		}
+	}
+
+	moveStruct       &operator[](int i)       { return moves[i]; }
+	const moveStruct &operator[](int i) const { return moves[i]; }
+};
+class boardClass
+{
+	// This class allows us to create a board objects. A board object holds the whole position: the board
+	//	array, both players' piece lists and whose turn it is. Moves are made and undone in place, so the
+	//	engine passes boards around by reference and never needs to copy one.
+
+private:
+	static const int initialBoard[120];
+
+public:
+	// The actual board with pieces on it
+	int board[120];
+
+	// The pieces for each player (see pieceClass for which piece lives in which slot)
+	pieceClass whitePieceList[16];
+	pieceClass blackPieceList[16];
+	int playersTurn; // 1=white, 0=black
+	int pieceIndexAt[120]; // the piece list slot of the piece standing on each square, -1 if empty;
+						   //	the board tells us which of the two piece lists the slot belongs to
+
+	// Bitboards of the same position, used by the bitboard move generator
+	bitboard pieceBB[2][7]; // pieces of each color ([0]=white, [1]=black) and identity (1=pawn ... 6=king)
+	bitboard colorBB[2];    // all pieces of each color
+
+	// Some useful values for easy functionality
+	int epSq; // this variable should hold the location of any pawn available for capture under en passant
+	int inCheck[2]; // 0 = no check, 1 = in check; inCheck[0] = white, inCheck[1] = black
+	static const int maxUndoDepth = 1024;
+	undoStruct undoStack[maxUndoDepth]; // everything needed to take back each move made so far, most recent last;
+								//	preallocated so that making and undoing moves never touches the heap
+	int undoCount; // the number of moves on the undo stack, i.e. how many moves can be undone
+	moveListClass legalMoves; // a list of all legal moves for the current position
+
+	// For scoring the board position
+	//	(the evaluation value for each move in legalMoves is kept in legalMoves.scores)
+	int alpha; // alpha
+	int beta;  // beta
+	int material; // the material difference between the players; 
+				  //	positive values mean white is ahead, negative mean black is ahead.
+	int positional; // the square table bonuses of all the pieces added up, again positive is good for white;
+					//	like material, kept up to date by makeMove() and undoMove()
+
+	// Zobrist hash key of the position, kept up to date by makeMove() and undoMove()
+	bitboard hashKey;
+
+	// Initialize the board
+	void initializeBoard(int board[120])
+	{
+		for (int i=0; i<120; i++)
+		{
+			board[i] = initialBoard[i];
+		}
+	}
+
+	// Piece list of a player (1=white, 0 or -1=black)
+	pieceClass       *getPieceList(int player)       { return (player == 1) ? whitePieceList : blackPieceList; }
+	const pieceClass *getPieceList(int player) const { return (player == 1) ? whitePieceList : blackPieceList; }
+
+	// Player to move in the 1=white, -1=black convention used by the move generator
+	int sideToMove() const { return playersTurn ? 1 : -1; }
+
+	// Castling rights in the 1=white kingside, 2=white queenside, 4=black kingside, 8=black queenside
+	//	bit convention. We don't store these; a side may castle as long as its king and that rook have
+	//	never moved (the same thing addCastlingMoves() checks before looking at the squares in between).
+	int castlingRights() const
+	{
+		int rights = 0;
+		if (whitePieceList[0].everMoved == 0)
+		{
+			if (whitePieceList[3].everMoved == 0 && whitePieceList[3].location == whitePieceList[0].location+3) rights |= 1;
+			if (whitePieceList[2].everMoved == 0 && whitePieceList[2].location == whitePieceList[0].location-4) rights |= 2;
+		}
+		if (blackPieceList[0].everMoved == 0)
+		{
+			if (blackPieceList[3].everMoved == 0 && blackPieceList[3].location == blackPieceList[0].location+3) rights |= 4;
+			if (blackPieceList[2].everMoved == 0 && blackPieceList[2].location == blackPieceList[0].location-4) rights |= 8;
+		}
+		return rights;
+	}
+
+	// Rebuild pieceIndexAt, the bitboards and the hash key from the piece lists; only needed after the piece
+	//	lists are set up from scratch
+	void syncFromPieceLists();
+
+	boardClass() 
+	{ 
+		initializeBoard(board); 
+		material = 0;
+		undoCount = 0;
+		epSq = 0;
+		playersTurn = 1;
+		syncFromPieceLists();
+	}
+};
+class squareTablesClass
+{
+private:
+	static const int pawnTable   [120];
+	static const int knightTable [120];
+	static const int bishopTable [120];
+	static const int kingTableMid[120];
+	static const int kingTableEnd[120];
+
+public:
+	int pawnTableW   [120];
+	int knightTableW [120];
+	int bishopTableW [120];
+	int kingTableMidW[120];
+	int kingTableEndW[120];
+	int pawnTableB   [120];
+	int knightTableB [120];
+	int bishopTableB [120];
+	int kingTableMidB[120];
+	int kingTableEndB[120];
+
+	// Initialize the board
+	void initializeTables(int pawnTableW[120], int knightTableW[120], int bishopTableW[120], int kingTableMidW[120], int kingTableEndW[120],
+						  int pawnTableB[120], int knightTableB[120], int bishopTableB[120], int kingTableMidB[120], int kingTableEndB[120])
+	{
+		for (int i=0; i<120; i++)
+		{
+			pawnTableW[i] = pawnTable[i];
+			pawnTableB[i] = pawnTable[119-i];
+
+			knightTableW[i] = knightTable[i];
+			knightTableB[i] = knightTable[119-i];
+
+			bishopTableW[i] = bishopTable[i];
+			bishopTableB[i] = bishopTable[119-i];
+
+			kingTableMidW[i] = kingTableMid[i];
+			kingTableMidB[i] = kingTableMid[119-i];
+
+			kingTableEndW[i] = kingTableEnd[i];
+			kingTableEndB[i] = kingTableEnd[119-i];
+		}
+	}
+
+	// The bonus of each piece on each square as used by the eval, [color: 0=white, 1=black][identity][location].
+	//	Black's bonuses are stored negated, so that a position's score is just the sum over all its pieces.
+	int pieceSquare[2][7][120];
+
+	squareTablesClass()
+	{
+		initializeTables(pawnTableW, knightTableW, bishopTableW, kingTableMidW, kingTableEndW,
+						 pawnTableB, knightTableB, bishopTableB, kingTableMidB, kingTableEndB);
+
+		// We currently don't care where queens and rooks go
+		for (int i=0; i<120; i++)
+		{
+			pieceSquare[0][0][i] = pieceSquare[1][0][i] = 0;
+			pieceSquare[0][1][i] =  pawnTableW[i];   pieceSquare[1][1][i] = -pawnTableB[i];
+			pieceSquare[0][2][i] =  knightTableW[i]; pieceSquare[1][2][i] = -knightTableB[i];
+			pieceSquare[0][3][i] =  bishopTableW[i]; pieceSquare[1][3][i] = -bishopTableB[i];
+			pieceSquare[0][4][i] = pieceSquare[1][4][i] = 0;
+			pieceSquare[0][5][i] = pieceSquare[1][5][i] = 0;
+			pieceSquare[0][6][i] =  kingTableMidW[i]; pieceSquare[1][6][i] = -kingTableMidB[i];
+		}
+	}
+};
+
+class bitboardTablesClass
+{
+	// Precomputed attack tables for the bitboard move generator, indexed by 64 square index.
+
+private:
+	static const bitboard knownBishopMagic[64]; // magic numbers found by initializeSliderTable()'s search,
+	static const bitboard knownRookMagic[64];   //	kept so that startup doesn't have to search again
+
+public:
+	bitboard knightAttacks[64];
+	bitboard kingAttacks[64];
+	bitboard pawnAttacks[2][64]; // squares attacked by a pawn on each square; [0]=white, [1]=black
+	bitboard rays[8][64];        // every square in each sliding direction, up to the edge of the board;
+								 //	directions 0-3 are diagonal, 4-7 are straight
+	int rayIncreasing[8];        // 1 if the squares along the direction have higher indices than the start
+	bitboard between[64][64];    // the squares strictly between two squares on the same line, 0 if not on a line
+
+	// Sliding piece attacks are looked up rather than traced. Only the squares in a slider's mask
+	//	(its lines, minus the board edges) can block it, so the occupied squares in the mask are turned
+	//	into an index into that square's slice of the attack table: with the PEXT instruction where the
+	//	compiler targets it, and with a magic multiply and shift otherwise.
+	bitboard bishopMask[64],  rookMask[64];
+	bitboard bishopMagic[64], rookMagic[64];
+	int      bishopShift[64], rookShift[64];
+	int      bishopTableStart[64], rookTableStart[64];
+	bitboard bishopTable[5248];   // 2^(bits in the mask) entries per square
+	bitboard rookTable[102400];
+
+	bitboardTablesClass();
+	bitboard rayAttacks(int square, bitboard occupied, int firstDirection, int lastDirection) const;
+	void     initializeSliderTable(int square, int bishop, int &tableStart);
+};
+
+class zobristTablesClass
+{
+	// Random keys for Zobrist hashing. A position's hash key is the XOR of the keys for each piece on its
+	//	square, the side to move, the castling rights and the en passant file. Making a move only changes a
+	//	few of these, so the key can be updated by XORing just those keys in and out.
+
+public:
+	bitboard pieceKeys[2][7][64]; // [color: 0=white, 1=black][identity][64 square index]
+	bitboard blackToMoveKey;      // XORed in when it is black's turn
+	bitboard castlingKeys[16];    // one per combination of castling rights (see boardClass::castlingRights())
+	bitboard epKeys[8];           // one per file of the en passant pawn
+
+	zobristTablesClass()
+	{
+		// The seed is fixed so the keys, and so the hash of every position, are the same on every run
+		bitboard seed = 1070372;
+		bitboard *keys[] = {&pieceKeys[0][0][0], &blackToMoveKey, castlingKeys, epKeys};
+		int numKeys[]    = {2*7*64, 1, 16, 8};
+		for (int k=0; k<4; k++)
+		{
+			for (int i=0; i<numKeys[k]; i++)
+			{
+				seed ^= seed >> 12; seed ^= seed << 25; seed ^= seed >> 27; // xorshift
+				keys[k][i] = seed * 2685821657736338717ULL;
+			}
+		}
+	}
+};
+
+// transposition table
+//	Entries record what a search has already found out about a position. Each entry is two 64-bit words:
+//	the packed data and the position's hash key XORed with that data. Several threads may read and write
+//	the table at once without locking; if two writes to an entry interleave, the key no longer XORs back
+//	out of it, so the torn entry simply looks like a miss.
+const int boundNone  = 0; // empty entry
+const int boundLower = 1; // the score is at least this (the search failed high)
+const int boundUpper = 2; // the score is at most this (the search failed low)
+const int boundExact = 3;
+
+struct ttEntryStruct
+{
+	std::atomic<bitboard> keyXorData;
+	std::atomic<bitboard> data; // bits 0-15 move, 16-31 score, 32-39 depth, 40-41 bound, 42-47 age
+};
+struct alignas(64) ttBucketStruct { ttEntryStruct entries[4]; }; // one cache line
+
+struct ttHitStruct { moveStruct move; int score, depth, bound; };
+
+class transpositionTableClass
+{
+public:
+	ttBucketStruct *buckets;
+	bitboard        numBuckets; // a power of two, so a hash key is turned into a bucket with a mask
+	int             age;        // bumped by every new search, so entries from old searches get replaced first
+
+	transpositionTableClass() { buckets = NULL; numBuckets = 0; age = 0; }
+	~transpositionTableClass() { delete[] buckets; }
+
+	// Allocates the largest power of two number of buckets that fits in the given number of MB
+	void resize(int megabytes)
+	{
+		delete[] buckets;
+		numBuckets = 1;
+		while (2*numBuckets*sizeof(ttBucketStruct) <= (bitboard)megabytes << 20)
+			numBuckets *= 2;
+		buckets = new ttBucketStruct[numBuckets];
+		clear();
+	}
+
+	void clear()
+	{
+		for (bitboard b=0; b<numBuckets; b++)
+		{
+			for (int i=0; i<4; i++)
+			{
+				buckets[b].entries[i].keyXorData.store(0, std::memory_order_relaxed);
+				buckets[b].entries[i].data.store(0, std::memory_order_relaxed);
+			}
+		}
+		age = 0;
+	}
+
+	void newSearch() { age = (age + 1) & 63; }
+
+	// Looks up a position; returns 1 and fills in hit if it is in the table, 0 if not
+	int probe(bitboard key, ttHitStruct &hit) const
+	{
+		const ttBucketStruct &bucket = buckets[key & (numBuckets-1)];
+		for (int i=0; i<4; i++)
+		{
+			bitboard data = bucket.entries[i].data.load(std::memory_order_relaxed);
+			if ((bucket.entries[i].keyXorData.load(std::memory_order_relaxed) ^ data) == key && ((data >> 40) & 3) != boundNone)
+			{
+				hit.move.data = (unsigned short)data;
+				hit.score     = (short)(data >> 16);
+				hit.depth     = (signed char)(data >> 32);
+				hit.bound     = (data >> 40) & 3;
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	// Stores what was found out about a position. The entry goes over the one already holding this
+	//	position if there is one, otherwise over the entry from the oldest search, the shallowest first.
+	void store(bitboard key, moveStruct move, int score, int depth, int bound)
+	{
+		ttBucketStruct &bucket = buckets[key & (numBuckets-1)];
+		ttEntryStruct *replace = &bucket.entries[0];
+		int replaceWorth = 1000000;
+		for (int i=0; i<4; i++)
+		{
+			ttEntryStruct &entry = bucket.entries[i];
+			bitboard data = entry.data.load(std::memory_order_relaxed);
+			if ((entry.keyXorData.load(std::memory_order_relaxed) ^ data) == key || ((data >> 40) & 3) == boundNone)
+			{
+				// A deeper result for the same position from this search is worth more than a shallower
+				//	one, unless the shallower one is exact
+				if (((data >> 40) & 3) != boundNone && bound != boundExact && (int)((data >> 42) & 63) == age &&
+					(signed char)(data >> 32) > depth)
+					return;
+				if (move.data == 0) // keep the best move we had if this search didn't find one
+					move.data = (unsigned short)data;
+				replace = &entry;
+				break;
+			}
+			int worth = (signed char)(data >> 32) - 8*((age - (int)(data >> 42)) & 63);
+			if (worth < replaceWorth)
+			{
+				replace = &entry;
+				replaceWorth = worth;
+			}
+		}
+
+		bitboard data = (bitboard)move.data | ((bitboard)(unsigned short)score << 16) | ((bitboard)(unsigned char)depth << 32) |
+						((bitboard)bound << 40) | ((bitboard)age << 42);
+		replace->keyXorData.store(key ^ data, std::memory_order_relaxed);
+		replace->data.store(data, std::memory_order_relaxed);
+	}
+};
+
+// search
+const int maxSearchPly  = 64;
+const int infiniteScore = 32000;
+const int mateScore     = 30000; // mate in n plies scores mateScore-n, so shorter mates score higher
+
+const int historyLimit  = 1 << 26; // history scores are halved before they get this big, so they can't overflow
+								   //	and moves that stopped causing cutoffs lose their place over time
+
+const int searchOutputText = 0; // progress printed for people to read
+const int searchOutputNone = 1; // nothing printed, for searches on the engine thread nobody asked to see
+const int searchOutputUci  = 2; // progress printed as UCI "info" lines
+
+struct searchLimitsStruct
+{
+	int    depth;   // stop after this depth
+	double seconds; //	or this many seconds (0 = no time limit)
+	int    output;  // how the search reports its progress (one of the searchOutput constants above)
+};
+
+struct searchResultStruct
+{
+	moveStruct bestMove; // data==0 if there is no legal move
+	int        score;    // from the point of view of the player to move
+	int        depth;    // the deepest iteration completed
+	unsigned long long nodes;
+	double     seconds;
+	moveStruct pv[maxSearchPly]; // the principal variation, bestMove first
+	int        pvLength;
+};
+
+struct searchStateStruct
+{
+	// Everything a search keeps track of while it runs
+	searchLimitsStruct limits;
+	double             stopTime;
+	unsigned long long nodes;
+	int                threadNumber; // 0 for the main search thread, which reports progress and decides when to stop
+	int                stopped; // 1 once we've run out of time or been told to stop; every search call then returns straight away
+	moveStruct         pvTable[maxSearchPly][maxSearchPly]; // pvTable[ply] is the best line found from ply on
+	int                pvLength[maxSearchPly];
+
+	// Move ordering
+	moveStruct         killers[maxSearchPly][2]; // the last two quiet moves to cause a cutoff at each ply
+	int                history[2][4096];         // [0=white, 1=black][from and to squares, i.e. the low 12 bits of the move]:
+												 //	how often each quiet move has caused a cutoff, weighted by depth
+};
+
+class movePickerClass
+{
+	// Hands out the moves of a position one at a time, most promising first, for the search to try in
+	//	that order. Moves are only generated once they are needed, in stages:
+	//	1) the move the transposition table remembers as best, if it can be played here
+	//	2) captures and promotions, most valuable victim first and, for the same victim, least valuable
+	//	   attacker first ("MVV-LVA"); promotions count as capturing the value the pawn gains
+	//	3) the killer moves of this ply
+	//	4) the other quiet moves, by their history score
+	//	5) the captures the static exchange evaluation says lose material, put aside during stage 2
+	//	A search that gets a cutoff from the hash move or a capture never generates the quiet moves, and
+	//	one that gets it from the hash move doesn't generate anything.
+
+public:
+	movePickerClass(const boardClass &board, const searchStateStruct &search, moveStruct ttMove, int ply, int capturesOnly);
+	int nextMove(moveStruct &move); // puts the next move in move and returns 1, or returns 0 once there are none left
+
+private:
+	static const int stageTTMove           = 0;
+	static const int stageGenerateCaptures = 1;
+	static const int stageGoodCaptures     = 2;
+	static const int stageKillers          = 3;
+	static const int stageGenerateQuiets   = 4;
+	static const int stageQuiets           = 5;
+	static const int stageBadCaptures      = 6;
+	static const int stageDone             = 7;
+
+	const boardClass        &board;
+	const searchStateStruct &search;
+	moveStruct    ttMove;
+	moveStruct    killers[2];
+	int           capturesOnly; // 1 to stop after the captures that don't lose material (for the quiescence search)
+	int           stage;
+	int           current;      // the next move to hand out from moves or badCaptures
+	moveListClass moves;        // the captures, later the quiet moves
+	moveListClass badCaptures;
+
+	void captureValues(moveStruct move, int &victimValue, int &attackerValue) const;
+};
+
+// engine thread
+const int engineIdle   = 0;
+const int engineSearch = 1; // search for a move to play
+const int enginePonder = 2; // search the position without playing anything, to fill the transposition table
+const int engineStop   = 3;
+const int engineQuit   = 4;
+
+struct engineCommandStruct
+{
+	int                type;     // one of the engine constants above
+	searchLimitsStruct limits;   // for engineSearch and enginePonder
+	boardClass         position; // the position to search, copied when the command is sent
+};
+
+class engineThreadClass
+{
+	// Runs the searches on a thread of its own, so the window keeps drawing and taking mouse clicks while
+	//	the ai thinks. The window sends commands, which the engine thread carries out one at a time, and
+	//	picks up the result of a search whenever it is ready. A new command supersedes whatever the engine
+	//	is doing: any search in progress is stopped through the stopSearch flag it polls.
+
+public:
+	engineThreadClass() { state = engineIdle; positionKey = 0; resultReady = 0; }
+
+	void start();
+	void quit();
+	void send(int type, const boardClass &position, searchLimitsStruct limits);
+	void stop();
+	int  takeResult(searchResultStruct &result, bitboard &resultKey); // 1 if a search for a move has finished since the last call
+
+	int      getState()       const { return state; }       // engineIdle, engineSearch or enginePonder
+	bitboard getPositionKey() const { return positionKey; } // hash key of the position being searched
+
+private:
+	std::thread                       worker;
+	std::mutex                        commandLock; // guards everything below that isn't atomic
+	std::condition_variable           commandReady;
+	std::deque<engineCommandStruct *> commands;
+	std::atomic<int>                  state;
+	std::atomic<bitboard>             positionKey;
+	searchResultStruct                result;
+	bitboard                          resultKey;
+	int                               resultReady;
+
+	void run();
+};
+
+// helper templates
+template <typename T> int sgn(T val) { // used for returning the sign of a variable with unknown type
+    return (T(0) < val) - (val < T(0));
+}
+
+// Function Table of Contents
+void displayBoardText			(const int board[120]);
+void initializePieceList		(pieceClass pieceList[16], int player);
+int  generatePseudoLegalMoveList(const boardClass &board, moveListClass &legalMoveList, int player);
+int  generatePseudoLegalMoveListMailbox (const boardClass &board, moveListClass &legalMoveList, int player);
+int  generateMoveListBitboard	(const boardClass &board, moveListClass &moveList, int player, bitboard targetMask,
+								 int withPromotions, int withCastling);
+int  generateCaptureMoveList	(const boardClass &board, moveListClass &moveList, int player);
+int  generateQuietMoveList		(const boardClass &board, moveListClass &moveList, int player);
+int  isPseudoLegalMove			(const boardClass &board, moveStruct move);
+int  isCaptureOrPromotion		(const boardClass &board, moveStruct move);
+int  addCastlingMoves			(const boardClass &board, moveListClass &legalMoveList, int player);
+int  addPawnMove				(moveListClass &legalMoveList, int from, int to);
+int  generateFullLegalMoveList  (boardClass &board, moveListClass &legalMoveList);
+int  generateLegalMoveListBitboard(const boardClass &board, moveListClass &legalMoveList);
+void printLegalMoveList			(const moveListClass &legalMoveList);
+void updatePieceInfo			(pieceClass pieceList[16]);
+void printPieceInfo				(const pieceClass pieceList[16]);
+void printDebugInfo				(const boardClass &board);
+void makeRandomMove				(const moveListClass &legalMoveList, boardClass &board);
+int  randomNumber				(int min_value, int max_value);
+int  inCheck					(const boardClass &board, int playerToCheck);
+int  isSquareAttacked			(const boardClass &board, int square, int byPlayer);
+int  isSquareAttackedMailbox	(const boardClass &board, int square, int byPlayer);
+int  isSquareAttackedBitboard	(const boardClass &board, int square, int byPlayer);
+bitboard bishopAttacks			(int square, bitboard occupied);
+bitboard rookAttacks			(int square, bitboard occupied);
+bitboard attackersTo			(const boardClass &board, int square, bitboard occupied);
+int  staticExchange				(const boardClass &board, moveStruct move);
+void makeMove                   (moveStruct move, boardClass &board);
+int  undoMove					(boardClass &board);
+bitboard computeHashKey			(const boardClass &board);
+int  computePositionalScore		(const boardClass &board);
+int  lazyEval					(const boardClass &board);
+void lazyEvalAllLegalMoves		(boardClass &board);
+void displayMoveScores			(const boardClass &board);
+int  checkMoveLegality			(moveStruct &potentialMove, const boardClass &board);
+int  loadFen					(const char *fen, boardClass &board);
+int  writeFen					(const boardClass &board, char fen[maxFenLength]);
+void moveToString				(moveStruct move, char moveString[6]);
+int  parseMove					(boardClass &board, const char *moveString, moveStruct &move);
+double getTimeInSeconds			(void);
+int  negamax					(boardClass &board, searchStateStruct &search, int depth, int ply, int alpha, int beta);
+int  quiescence					(boardClass &board, searchStateStruct &search, int ply, int alpha, int beta);
+int  checkSearchStop			(searchStateStruct &search);
+int  isRepetition				(const boardClass &board);
+void iterativeDeepening			(boardClass &board, searchStateStruct &search, searchResultStruct &result);
+void searchPosition				(boardClass &board, searchLimitsStruct limits, searchResultStruct &result);
+unsigned long long perft		(boardClass &board, int depth);
+void perftDivide				(boardClass &board, int depth);
+
+// global variables (defined in KingsmenEngine.cpp)
+extern zobristTablesClass zobristTables;
+extern transpositionTableClass transpositionTable;
+extern int hashSizeMB; // size of the transposition table
+extern std::atomic<int> searchThreads; // threads the ai searches with
+extern std::atomic<int> stopSearch; // set to 1 to make every search thread stop
+extern squareTablesClass squareTables;
+extern bitboardTablesClass bitboardTables;
+extern int moveGenBackend; // which move generator (and attack test) to use: 0=mailbox, 1=bitboard
+const int pieceValues[7] = {0, 100, 325, 335, 540, 1050, 0}; // indexed by identity
+
+#endif // KINGSMEN_ENGINE_H
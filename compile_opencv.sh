@@ -5,6 +5,11 @@
 # And relies on the opencv-dev package.
 #   Install with: "sudo apt-get install libopencv-dev"
 #   See: "http://karytech.blogspot.com/2012/05/opencv-24-on-ubuntu-1204.html"
+#
+# This is a quick unoptimized debug build of the window; the engine (KingsmenEngine.cpp)
+# is compiled in with it. For optimized builds, and the headless command line tool,
+# use CMake (see CMakeLists.txt). The code needs C++17, as the CMake build asks for; an
+# older compiler that defaults to C++98 has to be told, and one without C++17 can't build it.
 
  echo "compiling $1"
  if [[ $1 == *.c ]]
@@ -12,7 +17,7 @@
      gcc -ggdb `pkg-config --cflags opencv` -o `basename $1 .c` $1 `pkg-config --libs opencv`;
  elif [[ $1 == *.cpp ]]
  then
-     g++ -ggdb `pkg-config --cflags opencv` -o `basename $1 .cpp` $1 `pkg-config --libs opencv`;
+     g++ -std=c++17 -ggdb -pthread `pkg-config --cflags opencv` -o `basename $1 .cpp` $1 KingsmenEngine.cpp `pkg-config --libs opencv`;
 else
   echo "Please compile only .c or .cpp files"
 fi